@@ -0,0 +1,978 @@
+/*
+havSeriLite Benchmark
+
+Measures the writer and reader hot paths on representative workloads and reports throughput and allocations per value.
+
+Build and run from the repository root, for example:
+
+    g++ -std=c++17 -O2 -DNDEBUG -I. benchmark/havSeriLiteBenchmark.cpp -o havSeriLiteBenchmark
+    ./havSeriLiteBenchmark [--scale <factor>] [--iterations <count>] [--file <path>]
+
+"--scale" multiplies the size of every workload (default 1.0), "--iterations" sets how often each measurement is repeated (the
+fastest run is reported, default 5) and "--file" sets the temporary file used for the file-backed runs.
+
+Every decoding operation folds the values it reads into a checksum, which has to match that of the workload, otherwise the benchmark
+stops with exit code 1. Operations whose work does not grow with the payload report no MiB/s.
+*/
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <new>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include "havSeriLite.hpp"
+
+// Note: Counts every heap allocation of the process, so the allocations per value can be reported. All replaceable forms of
+// "operator new" and "operator delete" are replaced, so memory is always released by the function matching its allocation.
+namespace
+{
+    std::atomic<std::uint64_t> gNumOfAllocations { 0 };
+
+    void* Allocate(std::size_t size)
+    {
+        ++gNumOfAllocations;
+
+        if (void* pointer = std::malloc(size > 0 ? size : 1))
+        {
+            return pointer;
+        }
+
+        throw std::bad_alloc();
+    }
+
+    void* AllocateAligned(std::size_t size, std::align_val_t alignment)
+    {
+        ++gNumOfAllocations;
+
+#ifdef _WIN32
+        void* pointer = _aligned_malloc(size > 0 ? size : 1, static_cast<std::size_t>(alignment));
+#else
+        void* pointer = nullptr;
+
+        if (posix_memalign(&pointer, std::max(static_cast<std::size_t>(alignment), sizeof(void*)), size > 0 ? size : 1) != 0)
+        {
+            pointer = nullptr;
+        }
+#endif
+
+        if (pointer == nullptr)
+        {
+            throw std::bad_alloc();
+        }
+
+        return pointer;
+    }
+
+    void DeallocateAligned(void* pointer) noexcept
+    {
+#ifdef _WIN32
+        _aligned_free(pointer);
+#else
+        std::free(pointer);
+#endif
+    }
+}
+
+void* operator new(std::size_t size) { return Allocate(size); }
+void* operator new[](std::size_t size) { return Allocate(size); }
+void* operator new(std::size_t size, std::align_val_t alignment) { return AllocateAligned(size, alignment); }
+void* operator new[](std::size_t size, std::align_val_t alignment) { return AllocateAligned(size, alignment); }
+
+void operator delete(void* pointer) noexcept { std::free(pointer); }
+void operator delete[](void* pointer) noexcept { std::free(pointer); }
+void operator delete(void* pointer, std::size_t) noexcept { std::free(pointer); }
+void operator delete[](void* pointer, std::size_t) noexcept { std::free(pointer); }
+void operator delete(void* pointer, std::align_val_t) noexcept { DeallocateAligned(pointer); }
+void operator delete[](void* pointer, std::align_val_t) noexcept { DeallocateAligned(pointer); }
+void operator delete(void* pointer, std::size_t, std::align_val_t) noexcept { DeallocateAligned(pointer); }
+void operator delete[](void* pointer, std::size_t, std::align_val_t) noexcept { DeallocateAligned(pointer); }
+
+namespace
+{
+    using namespace havSeriLite;
+
+    struct BenchmarkPerson
+    {
+        std::string mFirstName;
+        std::string mLastName;
+        std::uint32_t mAge = 0;
+    };
+
+    HAVSERILITE_FIELDS(BenchmarkPerson, mFirstName, mLastName, mAge)
+
+    struct BenchmarkWorkload
+    {
+        std::string mName;
+        // Note: Writes the workload and returns the number of values written, not counting closing tags.
+        std::function<std::uint64_t(havSeriLiteWriter&)> mWrite;
+    };
+
+    struct BenchmarkEncoding
+    {
+        std::string mName;
+        havSeriLiteWriterOptions mOptions;
+    };
+
+    struct BenchmarkMeasurement
+    {
+        double mSeconds = 0.0;
+        std::uint64_t mNumOfAllocations = 0;
+    };
+
+    std::uint64_t WritePersons(havSeriLiteWriter& writer, std::size_t numOfPersons)
+    {
+        static const char* firstNames[] = { "Joe", "Jane", "John", "Mary", "Robert", "Patricia", "Michael", "Linda" };
+        static const char* lastNames[] = { "Smith", "Doe", "Johnson", "Williams", "Brown", "Jones", "Garcia", "Miller" };
+
+        writer.WriteArray();
+
+        for (std::size_t i = 0; i < numOfPersons; ++i)
+        {
+            writer.WriteObject();
+                writer.WriteString("FirstName"); writer.WriteString(firstNames[i % 8]);
+                writer.WriteString("LastName"); writer.WriteString(lastNames[(i / 8) % 8]);
+                writer.WriteString("Age"); writer.WriteUInt32(static_cast<std::uint32_t>(18 + i % 70));
+            writer.WriteCloseObject();
+        }
+
+        writer.WriteCloseArray();
+
+        return 1 + numOfPersons * 7;
+    }
+
+    std::uint64_t WriteNestedObjects(havSeriLiteWriter& writer, std::size_t numOfObjects)
+    {
+        constexpr std::size_t Depth = 16;
+
+        writer.WriteArray();
+
+        for (std::size_t i = 0; i < numOfObjects; ++i)
+        {
+            for (std::size_t level = 0; level < Depth; ++level)
+            {
+                writer.WriteObject();
+                writer.WriteString("Title"); writer.WriteString("Test");
+                writer.WriteString("Double"); writer.WriteDouble(1.234 * static_cast<double>(level));
+                writer.WriteString("Values"); writer.WriteArray();
+                    writer.WriteInt32(-1); writer.WriteUInt32(1); writer.WriteInt64(-1); writer.WriteUInt64(1); writer.WriteBool(true);
+                writer.WriteCloseArray();
+                writer.WriteString("Child");
+            }
+
+            writer.WriteString("Leaf");
+
+            for (std::size_t level = 0; level < Depth; ++level)
+            {
+                writer.WriteCloseObject();
+            }
+        }
+
+        writer.WriteCloseArray();
+
+        return 1 + numOfObjects * (Depth * 13 + 1);
+    }
+
+    std::uint64_t WriteNumbers(havSeriLiteWriter& writer, std::size_t numOfNumbers)
+    {
+        writer.WriteArray();
+
+        for (std::size_t i = 0; i < numOfNumbers; ++i)
+        {
+            if (i % 2 == 0)
+            {
+                writer.WriteInt64(static_cast<std::int64_t>(i) * 7919 - 1000000);
+            }
+            else
+            {
+                writer.WriteDouble(static_cast<double>(i) * 0.5);
+            }
+        }
+
+        writer.WriteCloseArray();
+
+        return 1 + numOfNumbers;
+    }
+
+    std::uint64_t WriteTypedNumbers(havSeriLiteWriter& writer, std::size_t numOfNumbers)
+    {
+        std::vector<double> values(numOfNumbers);
+
+        for (std::size_t i = 0; i < numOfNumbers; ++i)
+        {
+            values[i] = static_cast<double>(i) * 0.5;
+        }
+
+        writer.WriteTypedArray(values);
+
+        return 1 + numOfNumbers;
+    }
+
+    std::uint64_t WriteLongStrings(havSeriLiteWriter& writer, std::size_t numOfStrings)
+    {
+        const std::string value(64 * 1024, 'x');
+
+        writer.WriteArray();
+
+        for (std::size_t i = 0; i < numOfStrings; ++i)
+        {
+            writer.WriteString(value);
+        }
+
+        writer.WriteCloseArray();
+
+        return 1 + numOfStrings;
+    }
+
+    template<typename F>
+    BenchmarkMeasurement Measure(std::size_t numOfIterations, F&& function)
+    {
+        BenchmarkMeasurement result;
+
+        for (std::size_t i = 0; i < numOfIterations; ++i)
+        {
+            const std::uint64_t numOfAllocations = gNumOfAllocations.load();
+            const auto start = std::chrono::steady_clock::now();
+
+            function();
+
+            const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+            if (i == 0 || seconds < result.mSeconds)
+            {
+                result.mSeconds = seconds;
+            }
+
+            result.mNumOfAllocations = gNumOfAllocations.load() - numOfAllocations;
+        }
+
+        return result;
+    }
+
+    // Note: Folds the payload of every scalar value, including object keys and typed array elements, into a checksum in reading
+    // order. Every way of decoding a workload reads the same bytes and arrives at the same checksum, which is compared with a
+    // reference after each measurement, so no decoding can be skipped and no timed work can be dropped by the optimizer.
+    struct BenchmarkDigest
+    {
+        std::uint64_t mChecksum = Seed;
+        // Note: Elements of the last typed array, kept so that typed arrays are copied without allocating.
+        std::vector<double> mElements;
+
+        static constexpr std::uint64_t Seed = 14695981039346656037ull;
+
+        inline void Reset() { mChecksum = Seed; }
+
+        inline void Fold(std::uint64_t value) { mChecksum = (mChecksum ^ value) * 1099511628211ull; }
+        inline void Fold(std::string_view value) { Fold(static_cast<std::uint64_t>(std::hash<std::string_view> {}(value))); }
+
+        inline void Fold(double value)
+        {
+            std::uint64_t bits = 0;
+            std::memcpy(&bits, &value, sizeof(double));
+            Fold(bits);
+        }
+
+        inline void FoldElements()
+        {
+            for (double element : mElements)
+            {
+                Fold(element);
+            }
+        }
+
+        // Note: Folds the data of a "havSeriLiteValueView" or "havSeriLiteValue". Nulls, containers and closing tags have no payload.
+        template<typename Data>
+        void FoldData(const Data& data)
+        {
+            std::visit([this](const auto& payload) {
+                using T = std::decay_t<decltype(payload)>;
+
+                if constexpr (std::is_same_v<T, std::string_view> || std::is_same_v<T, double>)
+                {
+                    Fold(payload);
+                }
+                else if constexpr (std::is_same_v<T, havSeriLiteValue::havSeriLiteStringData>)
+                {
+                    Fold(std::string_view { payload.mValue });
+                }
+                else if constexpr (std::is_integral_v<T>)
+                {
+                    Fold(static_cast<std::uint64_t>(payload));
+                }
+            }, data);
+        }
+
+        template<typename V>
+        void FoldValue(havSeriLiteReader& reader, const V& value)
+        {
+            if (value.mType != havSeriLiteValueType::TypedArray)
+            {
+                FoldData(value.mData);
+            }
+            else if (reader.ReadTypedArray(value, mElements) == true)
+            {
+                FoldElements();
+            }
+        }
+    };
+
+    // Note: Visits every value with the iterators and returns the number of values, not counting closing tags.
+    std::uint64_t Traverse(havSeriLiteReader& reader, const havSeriLiteValueView& value, BenchmarkDigest& digest)
+    {
+        std::uint64_t numOfValues = 1;
+
+        digest.FoldValue(reader, value);
+
+        if (value.mType == havSeriLiteValueType::TypedArray)
+        {
+            return numOfValues + reader.TryReadTypedArray(value)->mCount;
+        }
+
+        // Note: Records are counted and folded like the objects they replace.
+        if (value.mType == havSeriLiteValueType::Record)
+        {
+            reader.ReadRecordFields(value, [&](std::string_view name, const havSeriLiteValueView& field) {
+                digest.Fold(name);
+                digest.FoldData(field.mData);
+                numOfValues += 2;
+            });
+
+            return numOfValues;
+        }
+
+        havSeriLiteValueView key { nullptr, havSeriLiteValueType::Null };
+        havSeriLiteValueView element { nullptr, havSeriLiteValueType::Null };
+
+        if (value.mType == havSeriLiteValueType::Array)
+        {
+            while (reader.ArrayIterator(value.mDepthLevel, element) == true)
+            {
+                numOfValues += Traverse(reader, element, digest);
+            }
+        }
+        else if (value.mType == havSeriLiteValueType::Object)
+        {
+            while (reader.ObjectIterator(value.mDepthLevel, key, element) == true)
+            {
+                digest.FoldData(key.mData);
+                numOfValues += 1 + Traverse(reader, element, digest);
+            }
+        }
+
+        return numOfValues;
+    }
+
+    // Note: Counts and folds the values reported by "havSeriLiteReader::Parse" like "Traverse".
+    struct DigestVisitor : havSeriLiteVisitor
+    {
+        BenchmarkDigest& mDigest;
+        std::uint64_t mNumOfValues = 0;
+
+        explicit DigestVisitor(BenchmarkDigest& digest) : mDigest(digest) {}
+
+        inline havSeriLiteVisitAction Count() { ++mNumOfValues; return havSeriLiteVisitAction::Continue; }
+
+        template<typename T>
+        inline havSeriLiteVisitAction Count(T value) { mDigest.Fold(value); return Count(); }
+
+        inline havSeriLiteVisitAction OnNull() { return Count(); }
+        inline havSeriLiteVisitAction OnBool(bool value) { return Count(static_cast<std::uint64_t>(value)); }
+        inline havSeriLiteVisitAction OnInt32(std::int32_t value) { return Count(static_cast<std::uint64_t>(value)); }
+        inline havSeriLiteVisitAction OnUInt32(std::uint32_t value) { return Count(static_cast<std::uint64_t>(value)); }
+        inline havSeriLiteVisitAction OnInt64(std::int64_t value) { return Count(static_cast<std::uint64_t>(value)); }
+        inline havSeriLiteVisitAction OnUInt64(std::uint64_t value) { return Count(value); }
+        inline havSeriLiteVisitAction OnDouble(double value) { return Count(value); }
+        inline havSeriLiteVisitAction OnString(std::string_view value) { return Count(value); }
+        inline havSeriLiteVisitAction OnKey(std::string_view value) { return Count(value); }
+        inline havSeriLiteVisitAction OnBeginArray() { return Count(); }
+        inline havSeriLiteVisitAction OnBeginObject() { return Count(); }
+    };
+
+    void FoldElement(const havSeriLiteElement& element, BenchmarkDigest& digest)
+    {
+        switch (element.GetType())
+        {
+            case havSeriLiteValueType::Boolean: digest.Fold(static_cast<std::uint64_t>(*element.TryGetBool())); break;
+            case havSeriLiteValueType::Int32:   digest.Fold(static_cast<std::uint64_t>(*element.TryGetInt32())); break;
+            case havSeriLiteValueType::UInt32:  digest.Fold(static_cast<std::uint64_t>(*element.TryGetUInt32())); break;
+            case havSeriLiteValueType::Int64:   digest.Fold(static_cast<std::uint64_t>(*element.TryGetInt64())); break;
+            case havSeriLiteValueType::UInt64:  digest.Fold(*element.TryGetUInt64()); break;
+            case havSeriLiteValueType::Double:  digest.Fold(*element.TryGetDouble()); break;
+            case havSeriLiteValueType::String:  digest.Fold(*element.TryGetString()); break;
+            case havSeriLiteValueType::Bytes:   digest.Fold(*element.TryGetBytes()); break;
+            case havSeriLiteValueType::TypedArray:
+                if (element.GetTypedArray(digest.mElements) == true)
+                {
+                    digest.FoldElements();
+                }
+                break;
+            default: break;
+        }
+    }
+
+    // Note: Visits every node of a parsed document and returns the number of values, counted and folded like "Traverse".
+    std::uint64_t TraverseDocument(const havSeriLiteElement& element, BenchmarkDigest& digest)
+    {
+        std::uint64_t numOfValues = 1;
+
+        FoldElement(element, digest);
+
+        if (element.GetType() == havSeriLiteValueType::TypedArray)
+        {
+            return numOfValues + element.GetSize();
+        }
+
+        const std::uint64_t numOfKeys = element.GetType() == havSeriLiteValueType::Object ? element.GetSize() : 0;
+
+        for (const havSeriLiteElement& child : element)
+        {
+            if (numOfKeys > 0)
+            {
+                FoldElement(child.GetKey(), digest);
+            }
+
+            numOfValues += TraverseDocument(child, digest);
+        }
+
+        return numOfValues + numOfKeys;
+    }
+
+    // Note: Reads and folds every token in order, including closing tags, until the input is exhausted.
+    template<typename ReadFunction>
+    std::uint64_t Walk(havSeriLiteReader& reader, ReadFunction&& read, BenchmarkDigest& digest)
+    {
+        std::uint64_t numOfTokens = 0;
+
+        for (auto value = read(reader); value.mType != havSeriLiteValueType::Null; value = read(reader))
+        {
+            digest.FoldValue(reader, value);
+            ++numOfTokens;
+        }
+
+        return numOfTokens;
+    }
+
+    havSeriLiteValue ReadNextValue(havSeriLiteReader& reader) { return reader.ReadValue(); }
+    havSeriLiteValueView ReadNextValueView(havSeriLiteReader& reader) { return reader.ReadValueView(); }
+
+    // Note: Reports an operation that read different values than the reference of its workload.
+    bool CheckDigest(const std::string& workload, const std::string& encoding, const std::string& operation, const BenchmarkDigest& digest, std::uint64_t expectedChecksum)
+    {
+        if (digest.mChecksum == expectedChecksum)
+        {
+            return true;
+        }
+
+        std::cerr << "Error: \"" << operation << "\" read different values from workload " << workload << " with encoding " << encoding << "!" << std::endl;
+        return false;
+    }
+
+    void OutputHeader()
+    {
+        std::cout << std::left << std::setw(14) << "Workload" << std::setw(12) << "Encoding" << std::setw(34) << "Operation"
+                  << std::right << std::setw(12) << "MiB" << std::setw(12) << "MiB/s" << std::setw(14) << "Mvalues/s" << std::setw(14) << "Allocs/value" << std::endl;
+    }
+
+    // Note: Reads a written workload back before anything is timed. It has to hold the written number of values, decode to the same
+    // values in every encoding (the checksum of the first one is kept in "referenceChecksum") and export the same JSON after its JSON
+    // was imported into the same encoding again.
+    bool CheckRoundTrip(const std::string& workload, const BenchmarkEncoding& encoding, const std::vector<char>& data, std::uint64_t numOfValues, std::optional<std::uint64_t>& referenceChecksum)
+    {
+        havSeriLiteReader reader(data.data(), data.size());
+        BenchmarkDigest digest;
+
+        if (Traverse(reader, reader.ReadValueView(), digest) != numOfValues)
+        {
+            std::cerr << "Error: Workload " << workload << " did not read back all values with encoding " << encoding.mName << "!" << std::endl;
+            return false;
+        }
+
+        if (referenceChecksum.has_value() == false)
+        {
+            referenceChecksum = digest.mChecksum;
+        }
+        else if (CheckDigest(workload, encoding.mName, "Read back", digest, *referenceChecksum) == false)
+        {
+            return false;
+        }
+
+        std::vector<char> json;
+        havSeriLiteMemorySink jsonSink(json);
+        reader.ReadBuffer(data.data(), data.size());
+
+        std::vector<char> imported;
+        havSeriLiteWriter writer(std::make_unique<havSeriLiteMemorySink>(imported), encoding.mOptions);
+        havSeriLiteJsonReader jsonReader(writer);
+
+        const bool converted = reader.ExportJson(jsonSink) == true && jsonReader.ReadBuffer(json.data(), json.size()) == true && writer.Flush() == true;
+
+        std::vector<char> exported;
+        havSeriLiteMemorySink exportedSink(exported);
+        havSeriLiteReader importedReader(imported.data(), imported.size());
+
+        if (converted == false || importedReader.ExportJson(exportedSink) == false || exported != json)
+        {
+            std::cerr << "Error: Workload " << workload << " changed on a JSON round trip with encoding " << encoding.mName << "!" << std::endl;
+            return false;
+        }
+
+        return true;
+    }
+
+    inline bool IsSamePerson(const BenchmarkPerson& person, const BenchmarkPerson& other)
+    {
+        return person.mFirstName == other.mFirstName && person.mLastName == other.mLastName && person.mAge == other.mAge;
+    }
+
+    // Note: Operations whose work does not grow with the payload (e.g. a document parse, which keeps strings as views into the input)
+    // set "perByte" to "false", so no MiB/s is reported for them.
+    void OutputMeasurement(const std::string& workload, const std::string& encoding, const std::string& operation, std::uint64_t numOfBytes, std::uint64_t numOfValues, const BenchmarkMeasurement& measurement, bool perByte = true)
+    {
+        const double mebibytes = static_cast<double>(numOfBytes) / (1024.0 * 1024.0);
+        const double seconds = measurement.mSeconds > 0.0 ? measurement.mSeconds : 1e-9;
+
+        std::cout << std::left << std::setw(14) << workload << std::setw(12) << encoding << std::setw(34) << operation
+                  << std::right << std::fixed << std::setprecision(2) << std::setw(12) << mebibytes << std::setw(12);
+
+        if (perByte == true)
+        {
+            std::cout << mebibytes / seconds;
+        }
+        else
+        {
+            std::cout << "-";
+        }
+
+        std::cout << std::setw(14) << static_cast<double>(numOfValues) / seconds / 1e6
+                  << std::setw(14) << std::setprecision(3) << static_cast<double>(measurement.mNumOfAllocations) / static_cast<double>(numOfValues) << std::endl;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    double scale = 1.0;
+    std::size_t numOfIterations = 5;
+    std::string fileName = "havSeriLiteBenchmark.bin";
+
+    for (int i = 1; i + 1 < argc; i += 2)
+    {
+        const std::string option = argv[i];
+
+        if (option == "--scale")
+        {
+            scale = std::atof(argv[i + 1]);
+        }
+        else if (option == "--iterations")
+        {
+            numOfIterations = static_cast<std::size_t>(std::max(1, std::atoi(argv[i + 1])));
+        }
+        else if (option == "--file")
+        {
+            fileName = argv[i + 1];
+        }
+        else
+        {
+            std::cerr << "Unknown option: " << option << std::endl;
+            return 1;
+        }
+    }
+
+    auto Scale = [scale](std::size_t count) {
+        return std::max<std::size_t>(1, static_cast<std::size_t>(static_cast<double>(count) * scale));
+    };
+
+    const std::vector<BenchmarkWorkload> workloads = {
+        { "Persons", [&](havSeriLiteWriter& writer) { return WritePersons(writer, Scale(200000)); } },
+        { "Nested", [&](havSeriLiteWriter& writer) { return WriteNestedObjects(writer, Scale(5000)); } },
+        { "Numbers", [&](havSeriLiteWriter& writer) { return WriteNumbers(writer, Scale(1000000)); } },
+        { "TypedArray", [&](havSeriLiteWriter& writer) { return WriteTypedNumbers(writer, Scale(4000000)); } },
+        { "LongStrings", [&](havSeriLiteWriter& writer) { return WriteLongStrings(writer, Scale(500)); } }
+    };
+
+    std::vector<BenchmarkEncoding> encodings(4);
+    encodings[0].mName = "Default";
+    encodings[1].mName = "Compact";
+    encodings[1].mOptions.mCompact = true;
+    encodings[2].mName = "Sized";
+    encodings[2].mOptions.mSizedContainers = true;
+    encodings[3].mName = "Dictionary";
+    encodings[3].mOptions.mCompact = true;
+    encodings[3].mOptions.mInternKeys = true;
+
+    OutputHeader();
+
+    for (const BenchmarkWorkload& workload : workloads)
+    {
+        std::optional<std::uint64_t> referenceChecksum;
+
+        for (const BenchmarkEncoding& encoding : encodings)
+        {
+            std::vector<char> data;
+            std::uint64_t numOfValues = 0;
+
+            {
+                havSeriLiteWriter writer(std::make_unique<havSeriLiteMemorySink>(data), encoding.mOptions);
+                numOfValues = workload.mWrite(writer);
+                writer.Flush();
+            }
+
+            if (CheckRoundTrip(workload.mName, encoding, data, numOfValues, referenceChecksum) == false)
+            {
+                return 1;
+            }
+
+            const BenchmarkMeasurement writeMemory = Measure(numOfIterations, [&]() {
+                data.clear();
+                havSeriLiteWriter writer(std::make_unique<havSeriLiteMemorySink>(data), encoding.mOptions);
+                numOfValues = workload.mWrite(writer);
+                writer.Flush();
+            });
+            OutputMeasurement(workload.mName, encoding.mName, "WriteValue (memory)", data.size(), numOfValues, writeMemory);
+
+            const BenchmarkMeasurement writeFile = Measure(numOfIterations, [&]() {
+                havSeriLiteWriter writer(fileName, encoding.mOptions);
+                workload.mWrite(writer);
+                writer.CloseFile();
+            });
+            OutputMeasurement(workload.mName, encoding.mName, "WriteValue (file)", data.size(), numOfValues, writeFile);
+
+            havSeriLiteReader reader(data.data(), data.size());
+            BenchmarkDigest digest;
+            Traverse(reader, reader.ReadValueView(), digest);
+            const std::uint64_t expectedChecksum = digest.mChecksum;
+
+            const BenchmarkMeasurement readValue = Measure(numOfIterations, [&]() {
+                reader.ReadBuffer(data.data(), data.size());
+                digest.Reset();
+                Walk(reader, ReadNextValue, digest);
+            });
+            OutputMeasurement(workload.mName, encoding.mName, "ReadValue (memory)", data.size(), numOfValues, readValue);
+
+            if (CheckDigest(workload.mName, encoding.mName, "ReadValue", digest, expectedChecksum) == false)
+            {
+                return 1;
+            }
+
+            const BenchmarkMeasurement readValueView = Measure(numOfIterations, [&]() {
+                reader.ReadBuffer(data.data(), data.size());
+                digest.Reset();
+                Walk(reader, ReadNextValueView, digest);
+            });
+            OutputMeasurement(workload.mName, encoding.mName, "ReadValueView (memory)", data.size(), numOfValues, readValueView);
+
+            if (CheckDigest(workload.mName, encoding.mName, "ReadValueView", digest, expectedChecksum) == false)
+            {
+                return 1;
+            }
+
+            const BenchmarkMeasurement iterate = Measure(numOfIterations, [&]() {
+                reader.ReadBuffer(data.data(), data.size());
+                digest.Reset();
+                Traverse(reader, reader.ReadValueView(), digest);
+            });
+            OutputMeasurement(workload.mName, encoding.mName, "Iterators (memory)", data.size(), numOfValues, iterate);
+
+            if (CheckDigest(workload.mName, encoding.mName, "Iterators", digest, expectedChecksum) == false)
+            {
+                return 1;
+            }
+
+            const BenchmarkMeasurement parse = Measure(numOfIterations, [&]() {
+                reader.ReadBuffer(data.data(), data.size());
+                digest.Reset();
+                DigestVisitor visitor(digest);
+                reader.Parse(visitor);
+            });
+            OutputMeasurement(workload.mName, encoding.mName, "Parse (memory)", data.size(), numOfValues, parse);
+
+            if (CheckDigest(workload.mName, encoding.mName, "Parse", digest, expectedChecksum) == false)
+            {
+                return 1;
+            }
+
+            havSeriLiteDocument document;
+
+            const BenchmarkMeasurement parseDocument = Measure(numOfIterations, [&]() {
+                reader.ReadBuffer(data.data(), data.size());
+                document.Parse(reader);
+            });
+            OutputMeasurement(workload.mName, encoding.mName, "Document parse (memory)", data.size(), numOfValues, parseDocument, false);
+
+            const BenchmarkMeasurement traverseDocument = Measure(numOfIterations, [&]() {
+                digest.Reset();
+                TraverseDocument(document.GetRoot(), digest);
+            });
+            OutputMeasurement(workload.mName, encoding.mName, "Document traversal", data.size(), numOfValues, traverseDocument);
+
+            if (CheckDigest(workload.mName, encoding.mName, "Document traversal", digest, expectedChecksum) == false)
+            {
+                return 1;
+            }
+
+            std::vector<char> json;
+
+            const BenchmarkMeasurement exportJson = Measure(numOfIterations, [&]() {
+                json.clear();
+                havSeriLiteMemorySink sink(json);
+                reader.ReadBuffer(data.data(), data.size());
+                reader.ExportJson(sink);
+            });
+            OutputMeasurement(workload.mName, encoding.mName, "ExportJson (memory)", data.size(), numOfValues, exportJson);
+
+            std::vector<char> imported;
+
+            const BenchmarkMeasurement importJson = Measure(numOfIterations, [&]() {
+                imported.clear();
+                havSeriLiteWriter writer(std::make_unique<havSeriLiteMemorySink>(imported), encoding.mOptions);
+                havSeriLiteJsonReader jsonReader(writer);
+                jsonReader.ReadBuffer(json.data(), json.size());
+                writer.Flush();
+            });
+            OutputMeasurement(workload.mName, encoding.mName, "ImportJson (memory)", json.size(), numOfValues, importJson);
+
+            const std::pair<havSeriLiteLoadMode, const char*> loadModes[] = {
+                { havSeriLiteLoadMode::Buffered, "ReadFile (buffered)" },
+                { havSeriLiteLoadMode::MemoryMapped, "ReadFile (mapped)" },
+                { havSeriLiteLoadMode::Streamed, "ReadFile (streamed)" }
+            };
+
+            for (const auto& loadMode : loadModes)
+            {
+                const BenchmarkMeasurement readFile = Measure(numOfIterations, [&]() {
+                    reader.ReadFile(fileName, loadMode.first);
+                    digest.Reset();
+                    Traverse(reader, reader.ReadValueView(), digest);
+                });
+                OutputMeasurement(workload.mName, encoding.mName, std::string(loadMode.second) + " + Iterators", data.size(), numOfValues, readFile);
+
+                if (CheckDigest(workload.mName, encoding.mName, loadMode.second, digest, expectedChecksum) == false)
+                {
+                    return 1;
+                }
+            }
+        }
+    }
+
+    // Note: Compares decoding reflected types from objects with decoding them from records of the same layout.
+    std::vector<BenchmarkPerson> persons(Scale(200000));
+
+    for (std::size_t i = 0; i < persons.size(); ++i)
+    {
+        persons[i] = BenchmarkPerson { i % 2 == 0 ? "Joe" : "Jane", i % 3 == 0 ? "Smith" : "Doe", static_cast<std::uint32_t>(18 + i % 70) };
+    }
+
+    std::vector<BenchmarkEncoding> typedEncodings(2);
+    typedEncodings[0].mName = "Compact";
+    typedEncodings[0].mOptions.mCompact = true;
+    typedEncodings[1].mName = "Records";
+    typedEncodings[1].mOptions.mCompact = true;
+    typedEncodings[1].mOptions.mRecords = true;
+
+    std::optional<std::uint64_t> referenceChecksum;
+
+    for (const BenchmarkEncoding& encoding : typedEncodings)
+    {
+        std::vector<char> data;
+        const std::uint64_t numOfValues = 1 + persons.size() * 7;
+        std::vector<BenchmarkPerson> result;
+
+        {
+            havSeriLiteWriter writer(std::make_unique<havSeriLiteMemorySink>(data), encoding.mOptions);
+            Write(writer, persons);
+            writer.Flush();
+        }
+
+        if (CheckRoundTrip("Persons", encoding, data, numOfValues, referenceChecksum) == false)
+        {
+            return 1;
+        }
+
+        {
+            havSeriLiteReader reader(data.data(), data.size());
+
+            if (Read(reader, result) == false || std::equal(result.begin(), result.end(), persons.begin(), persons.end(), IsSamePerson) == false)
+            {
+                std::cerr << "Error: Read<T> did not return the persons written with encoding " << encoding.mName << "!" << std::endl;
+                return 1;
+            }
+        }
+
+        const BenchmarkMeasurement writeTyped = Measure(numOfIterations, [&]() {
+            data.clear();
+            havSeriLiteWriter writer(std::make_unique<havSeriLiteMemorySink>(data), encoding.mOptions);
+            Write(writer, persons);
+            writer.Flush();
+        });
+        OutputMeasurement("Persons", encoding.mName, "Write<T> (memory)", data.size(), numOfValues, writeTyped);
+
+        havSeriLiteReader reader(data.data(), data.size());
+        result.clear();
+
+        const BenchmarkMeasurement readTyped = Measure(numOfIterations, [&]() {
+            reader.ReadBuffer(data.data(), data.size());
+            Read(reader, result);
+        });
+        OutputMeasurement("Persons", encoding.mName, "Read<T> (memory)", data.size(), numOfValues, readTyped);
+
+        if (std::equal(result.begin(), result.end(), persons.begin(), persons.end(), IsSamePerson) == false)
+        {
+            std::cerr << "Error: Read<T> read different persons with encoding " << encoding.mName << "!" << std::endl;
+            return 1;
+        }
+
+        // Note: Looks up a field of every person by path, which has to resolve the same whether persons are objects or records.
+        std::vector<std::string> paths(persons.size());
+
+        for (std::size_t i = 0; i < persons.size(); ++i)
+        {
+            paths[i] = std::to_string(i) + "/Age";
+        }
+
+        reader.ReadBuffer(data.data(), data.size());
+        BenchmarkDigest digest;
+
+        for (std::size_t i = 0; i < persons.size(); ++i)
+        {
+            const havSeriLiteValueView age = reader.FindView(paths[i]);
+
+            if (age.mType != havSeriLiteValueType::UInt32 || std::get<std::uint32_t>(age.mData) != persons[i].mAge)
+            {
+                std::cerr << "Error: \"" << paths[i] << "\" did not resolve with encoding " << encoding.mName << "!" << std::endl;
+                return 1;
+            }
+
+            digest.FoldData(age.mData);
+        }
+
+        const std::uint64_t expectedChecksum = digest.mChecksum;
+
+        const BenchmarkMeasurement find = Measure(numOfIterations, [&]() {
+            digest.Reset();
+
+            for (const std::string& path : paths)
+            {
+                digest.FoldData(reader.FindView(path).mData);
+            }
+        });
+        OutputMeasurement("Persons", encoding.mName, "Find (memory, indexed)", data.size(), persons.size(), find, false);
+
+        if (CheckDigest("Persons", encoding.mName, "Find", digest, expectedChecksum) == false)
+        {
+            return 1;
+        }
+    }
+
+    // Note: Encodes and decodes every person as a message of its own, once with a writer and reader created per message and once
+    // with long-lived ones that are reset for every message. Every decoded person is compared with the original.
+    std::vector<char> message;
+    std::uint64_t messageSize = 0;
+    const std::uint64_t numOfMessageValues = persons.size() * 7;
+    std::size_t numOfMismatches = 0;
+
+    const BenchmarkMeasurement newMessages = Measure(numOfIterations, [&]() {
+        BenchmarkPerson person;
+        messageSize = 0;
+
+        for (const BenchmarkPerson& original : persons)
+        {
+            message.clear();
+            havSeriLiteWriter writer(std::make_unique<havSeriLiteMemorySink>(message), typedEncodings[0].mOptions);
+            Write(writer, original);
+            writer.Flush();
+
+            havSeriLiteReader reader(message.data(), message.size());
+            numOfMismatches += Read(reader, person) == false || IsSamePerson(person, original) == false ? 1 : 0;
+            messageSize += message.size();
+        }
+    });
+    OutputMeasurement("Persons", typedEncodings[0].mName, "Message round trip (new)", messageSize, numOfMessageValues, newMessages);
+
+    havSeriLiteWriter messageWriter(typedEncodings[0].mOptions);
+    havSeriLiteReader messageReader;
+
+    const BenchmarkMeasurement resetMessages = Measure(numOfIterations, [&]() {
+        BenchmarkPerson person;
+
+        for (const BenchmarkPerson& original : persons)
+        {
+            message.clear();
+            messageWriter.Reset(message);
+            Write(messageWriter, original);
+            messageWriter.Flush();
+
+            messageReader.Reset(message.data(), message.size());
+            numOfMismatches += Read(messageReader, person) == false || IsSamePerson(person, original) == false ? 1 : 0;
+        }
+    });
+    OutputMeasurement("Persons", typedEncodings[0].mName, "Message round trip (reset)", messageSize, numOfMessageValues, resetMessages);
+
+    if (numOfMismatches > 0)
+    {
+        std::cerr << "Error: " << numOfMismatches << " messages did not round trip!" << std::endl;
+        return 1;
+    }
+
+    // Note: Appends every person as a record of its own. Commits are not synced, as the cost of "fsync" depends on the device.
+    havSeriLiteLogOptions logOptions;
+    logOptions.mWriterOptions = typedEncodings[0].mOptions;
+    logOptions.mSync = false;
+
+    std::uint64_t logSize = 0;
+    const std::uint64_t numOfLogValues = persons.size() * 7;
+
+    const BenchmarkMeasurement appendLog = Measure(numOfIterations, [&]() {
+        std::remove(fileName.c_str());
+        havSeriLiteLogWriter logWriter(logOptions);
+        logWriter.Open(fileName);
+
+        for (const BenchmarkPerson& person : persons)
+        {
+            logWriter.Append([&](havSeriLiteWriter& writer) { Write(writer, person); });
+        }
+
+        logWriter.Commit();
+        logSize = logWriter.GetSize();
+    });
+    OutputMeasurement("Persons", typedEncodings[0].mName, "Log append (file)", logSize, numOfLogValues, appendLog);
+
+    std::size_t numOfRecords = 0;
+
+    const BenchmarkMeasurement readLog = Measure(numOfIterations, [&]() {
+        havSeriLiteLogReader logReader;
+        logReader.Open(fileName);
+        BenchmarkPerson person;
+        numOfRecords = 0;
+
+        while (logReader.ReadRecord() == true)
+        {
+            messageReader.Reset(logReader.GetRecord().data(), logReader.GetRecord().size());
+            const bool read = Read(messageReader, person);
+            numOfMismatches += read == false || numOfRecords >= persons.size() || IsSamePerson(person, persons[numOfRecords]) == false ? 1 : 0;
+            ++numOfRecords;
+        }
+    });
+    OutputMeasurement("Persons", typedEncodings[0].mName, "Log read (file)", logSize, numOfLogValues, readLog);
+
+    if (numOfMismatches > 0 || numOfRecords != persons.size())
+    {
+        std::cerr << "Error: The log did not read back the persons appended to it!" << std::endl;
+        return 1;
+    }
+
+    std::remove(fileName.c_str());
+
+    return 0;
+}
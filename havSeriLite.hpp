@@ -68,17 +68,66 @@ SOFTWARE.
 #undef WIN32_LEAN_AND_MEAN
 #define WIN32_LEAN_AND_MEAN
 #include <windows.h>
+#include <io.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#endif
+
+#if defined(_MSVC_LANG) && _MSVC_LANG > __cplusplus
+#define HAVSERILITE_CPLUSPLUS _MSVC_LANG
+#else
+#define HAVSERILITE_CPLUSPLUS __cplusplus
+#endif
+
+#if HAVSERILITE_CPLUSPLUS >= 202002L
+#define HAVSERILITE_HAS_SPAN 1
+#include <span>
+#else
+#define HAVSERILITE_HAS_SPAN 0
+#endif
+
+// Define HAVSERILITE_ENABLE_STATS as 1 before including this header to let readers and writers collect statistics (see "havSeriLiteStats")
+
+#ifndef HAVSERILITE_ENABLE_STATS
+#define HAVSERILITE_ENABLE_STATS 0
+#endif
+
+#if HAVSERILITE_ENABLE_STATS
+#define HAVSERILITE_STATS(statement) statement
+#else
+#define HAVSERILITE_STATS(statement)
 #endif
 
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cerrno>
+#include <charconv>
+#include <chrono>
+#include <cstddef>
 #include <cstdio>
 #include <cstdint>
+#include <cstdlib>
 #include <cstring>
+#include <deque>
+#include <exception>
 #include <functional>
 #include <iostream>
-#include <iomanip>
+#include <iterator>
+#include <limits>
+#include <mutex>
 #include <string>
+#include <string_view>
 #include <stdexcept>
+#include <thread>
+#include <tuple>
 #include <type_traits>
+#include <unordered_map>
+#include <utility>
 #include <memory>
 #include <optional>
 #include <variant>
@@ -109,7 +158,289 @@ namespace havSeriLite
         Double,
         String,
         Array,
-        Object
+        Object,
+        // Note: Homogeneous array of Int32, UInt32, Int64, UInt64 or Double elements stored as one packed payload.
+        TypedArray,
+        // Note: Object of a fixed layout declared once as a schema, whose field values are stored without tags or keys.
+        Record,
+        // Note: Binary data, stored like a string but never interned.
+        Bytes
+    };
+
+    // Note: Wire-level tags and modifiers that are never surfaced as "havSeriLiteValueType".
+    enum class havSeriLiteWireTag : std::uint8_t
+    {
+        // Note: Inline booleans and empty strings without payload.
+        False = 0x20,
+        True = 0x21,
+        EmptyString = 0x22,
+        // Note: Dictionary strings (see "havSeriLiteFormatFlag::Dictionary"). A definition carries a varint id, the length and the bytes
+        // of a string, a reference only the varint id. References to ids below 64 are inline as 0b01iiiiii.
+        StringReference = 0x23,
+        StringDefinition = 0x24,
+        // Note: Records (see "havSeriLiteFormatFlag::Records"). A definition carries a varint schema id, the varint number of fields
+        // and the type tag, varint name length and name of each field, a reference only the varint schema id. Both are followed by
+        // the field values in schema order: booleans as one byte, numbers in native byte order and strings as varint length and bytes.
+        RecordDefinition = 0x25,
+        RecordReference = 0x26,
+        SmallStringReference = 0x40,
+        // Note: Set on an "Array" or "Object" tag when it is followed by the container's byte length and element count.
+        SizedFlag = 0x80,
+        // Note: Inline small integers as 0b11ttvvvv, where tt selects Int32, UInt32, Int64 or UInt64 and vvvv holds the (zigzag encoded) value.
+        SmallInteger = 0xC0
+    };
+
+    enum class havSeriLiteFormatFlag : std::uint8_t
+    {
+        // Note: Integers and string lengths are LEB128 varints (zigzag encoded for signed types), small values use inline tags.
+        Compact = 0x01,
+        // Note: Repeated strings are written once as a definition and then referenced by id.
+        Dictionary = 0x02,
+        // Note: Objects of a fixed layout are written as records whose schema is defined once and then referenced by id.
+        Records = 0x04
+    };
+
+    // Note: Files using any optional encoding start with this header, files without it are read with the original encoding.
+    struct havSeriLiteHeader
+    {
+        static constexpr char Magic[3] = { 'H', 'S', 'L' };
+        static constexpr std::uint8_t Version = 1;
+        static constexpr std::uint8_t SupportedFlags = static_cast<std::uint8_t>(havSeriLiteFormatFlag::Compact) | static_cast<std::uint8_t>(havSeriLiteFormatFlag::Dictionary) | static_cast<std::uint8_t>(havSeriLiteFormatFlag::Records);
+        // Note: Magic, version and format flags.
+        static constexpr std::size_t Size = sizeof(Magic) + 2;
+    };
+
+    struct havSeriLiteWriterOptions
+    {
+        std::size_t mBufferCapacity = 64 * 1024;
+        // Note: Writes arrays and objects with their byte length and element count, so readers can skip them in constant time.
+        // Sinks that can write back (files and seekable descriptors) get their output as usual and have the sizes patched in place,
+        // other sinks (memory, streams, pipes, compressed files) receive nothing until the outermost sized container is closed, so
+        // the whole container is held in memory.
+        bool mSizedContainers = false;
+        // Note: Writes integers and string lengths as varints and small values as inline tags (see "havSeriLiteFormatFlag::Compact").
+        bool mCompact = false;
+        // Note: Writes repeated object keys, and optionally repeated string values, once and refers back to them by id afterwards
+        // (see "havSeriLiteFormatFlag::Dictionary"). At most "mMaxInternedStrings" strings are kept, later ones are written in full.
+        bool mInternKeys = false;
+        bool mInternValues = false;
+        std::uint32_t mMaxInternedStrings = 65536;
+        // Note: Writes types described with "HAVSERILITE_FIELDS" whose fields are all booleans, numbers or strings as records
+        // (see "havSeriLiteFormatFlag::Records"), so readers decode them as a fixed sequence of loads.
+        bool mRecords = false;
+        // Note: Compresses files written with "WriteFile" in independently decodable blocks of this size (see "havSeriLiteBlockSink").
+        // Zero disables compression. Readers detect compressed files on their own.
+        std::size_t mCompressedBlockSize = 0;
+    };
+
+    struct havSeriLiteStreamOptions
+    {
+        std::size_t mWindowSize = 1024 * 1024;
+        // Note: The window grows beyond "mWindowSize" to hold a single value larger than it, up to this limit.
+        std::uint64_t mMaxValueSize = 256 * 1024 * 1024;
+    };
+
+    struct havSeriLiteLogOptions
+    {
+        // Note: Encoding of the records. Dictionaries and record schemas start over in every record, so each one decodes on its own.
+        // "mCompressedBlockSize" does not apply to logs.
+        havSeriLiteWriterOptions mWriterOptions;
+        // Note: Records are collected and committed together (group commit) once this many are pending, their size reaches
+        // "mMaxPendingBytes" or the oldest one has waited "mMaxPendingTime". A limit of one commits every record on its own. The age
+        // is checked by "Append" and "CommitIfDue", so call the latter periodically to bound it when records may stop arriving.
+        std::size_t mMaxPendingRecords = 256;
+        std::size_t mMaxPendingBytes = 1024 * 1024;
+        std::chrono::milliseconds mMaxPendingTime = std::chrono::milliseconds(50);
+        // Note: Syncs every commit to the storage device ("fsync"). Without it, committed records survive a crash of the process
+        // but not of the system.
+        bool mSync = true;
+    };
+
+    // Note: Counters of a reader or writer, collected only if "HAVSERILITE_ENABLE_STATS" is 1. Counters that do not apply to one side stay zero.
+    struct havSeriLiteStats
+    {
+        static constexpr std::size_t NumOfValueTypes = static_cast<std::size_t>(havSeriLiteValueType::Bytes) + 1;
+
+        // Note: Bytes loaded from the input (reader) or handed to the sink (writer).
+        std::uint64_t mNumOfBytes = 0;
+        // Note: Values read or written by type (see "GetNumOfValues"). Closing tags are counted as "Close".
+        std::array<std::uint64_t, NumOfValueTypes> mNumOfValues {};
+        // Note: Bytes of all string values and keys, and number of strings copied into memory allocated for them.
+        std::uint64_t mNumOfStringBytes = 0;
+        std::uint64_t mNumOfStringAllocations = 0;
+        std::int32_t mMaxDepthLevel = 0;
+        // Note: Containers left before reading their closing tag, whether jumped over or scanned.
+        std::uint64_t mNumOfSkippedContainers = 0;
+        // Note: Buffers handed to the sink (writer) and window refills of a streamed input (reader).
+        std::uint64_t mNumOfFlushes = 0;
+        std::uint64_t mNumOfRefills = 0;
+        // Note: Malformed input or failed sink writes, and the input offset of the last malformed value.
+        std::uint64_t mNumOfErrors = 0;
+        std::uint64_t mLastErrorOffset = 0;
+        // Note: Time spent loading input (reading, mapping, decompressing and refilling), decoding whole values into documents, indexes
+        // or JSON, and writing to the sink.
+        std::chrono::nanoseconds mLoadTime { 0 };
+        std::chrono::nanoseconds mDecodeTime { 0 };
+        std::chrono::nanoseconds mFlushTime { 0 };
+
+        inline std::uint64_t GetNumOfValues(havSeriLiteValueType type) const { return mNumOfValues[static_cast<std::size_t>(type)]; }
+    };
+
+    // Note: Adds the time until it goes out of scope to "duration".
+    class havSeriLiteStatsTimer
+    {
+    public:
+        explicit havSeriLiteStatsTimer(std::chrono::nanoseconds& duration) : mDuration(duration), mStart(std::chrono::steady_clock::now()) {}
+
+        havSeriLiteStatsTimer(const havSeriLiteStatsTimer&) = delete;
+        havSeriLiteStatsTimer& operator=(const havSeriLiteStatsTimer&) = delete;
+
+        ~havSeriLiteStatsTimer()
+        {
+            mDuration += std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - mStart);
+        }
+
+    private:
+        std::chrono::nanoseconds& mDuration;
+        std::chrono::steady_clock::time_point mStart;
+    };
+
+    inline std::uint64_t ZigZagEncode(std::int64_t value)
+    {
+        return (static_cast<std::uint64_t>(value) << 1) ^ static_cast<std::uint64_t>(value >> 63);
+    }
+
+    inline std::int64_t ZigZagDecode(std::uint64_t value)
+    {
+        return static_cast<std::int64_t>(value >> 1) ^ -static_cast<std::int64_t>(value & 1);
+    }
+
+    // Note: Decodes a varint from memory that has already been validated (e.g. a record read by "havSeriLiteReader") and advances "data".
+    inline std::uint64_t DecodeVarint(const char*& data)
+    {
+        std::uint64_t value = 0;
+
+        for (std::uint32_t shift = 0; ; shift += 7)
+        {
+            const std::uint8_t byte = static_cast<std::uint8_t>(*data++);
+            value |= static_cast<std::uint64_t>(byte & 0x7F) << shift;
+
+            if ((byte & 0x80) == 0)
+            {
+                return value;
+            }
+        }
+    }
+
+    enum class havSeriLiteLoadMode : std::uint8_t
+    {
+        // Note: Reads the whole file with a single bulk read into a pre-sized buffer owned by the reader.
+        Buffered,
+        // Note: Maps the file read-only into memory, so no copy of the file contents is made.
+        MemoryMapped,
+        // Note: Reads the file through a fixed-size window (see "havSeriLiteStreamOptions"), so memory use does not grow with the file size.
+        Streamed
+    };
+
+    struct havSeriLiteContainerData
+    {
+        // Note: Offset of the first element in the input.
+        std::uint64_t mOffset = 0;
+        // Note: Byte length up to and including the closing tag and number of elements (key-value pairs for objects), both zero when unknown.
+        std::uint64_t mByteSize = 0;
+        std::uint64_t mCount = 0;
+
+        // Note: Set in the stored element count of a sized container that defines dictionary strings or record schemas, so readers
+        // read through it instead of jumping over it and missing the definitions.
+        static constexpr std::uint64_t DefinesStringsFlag = std::uint64_t { 1 } << 63;
+    };
+
+    // Note: Consecutive elements of an array (or key-value pairs of an object), as produced by "havSeriLiteReader::SplitContainer".
+    struct havSeriLiteElementRange
+    {
+        // Note: Input offsets of the first element and of the byte following the last one.
+        std::uint64_t mOffset = 0;
+        std::uint64_t mEnd = 0;
+        // Note: Index of the first element within the container and number of elements in the range.
+        std::uint64_t mFirstElement = 0;
+        std::uint64_t mNumOfElements = 0;
+    };
+
+    struct havSeriLiteTypedArrayData
+    {
+        havSeriLiteValueType mElementType = havSeriLiteValueType::Null;
+        std::uint64_t mCount = 0;
+        // Note: Offset of the packed elements in the input.
+        std::uint64_t mOffset = 0;
+    };
+
+    struct havSeriLiteRecordData
+    {
+        std::uint32_t mSchemaId = 0;
+        // Note: Offset and byte length of the field values in the input.
+        std::uint64_t mOffset = 0;
+        std::uint64_t mByteSize = 0;
+    };
+
+    // Note: Field of a record schema. Fields can be of type Boolean, Int32, UInt32, Int64, UInt64, Double or String.
+    struct havSeriLiteSchemaField
+    {
+        std::string_view mName;
+        havSeriLiteValueType mType = havSeriLiteValueType::Null;
+    };
+
+    // Note: Size of a record field in bytes, zero for strings (which are stored with their length) and unsupported types.
+    inline std::size_t GetRecordFieldSize(havSeriLiteValueType type)
+    {
+        switch (type)
+        {
+            case havSeriLiteValueType::Boolean: return sizeof(std::uint8_t);
+            case havSeriLiteValueType::Int32:
+            case havSeriLiteValueType::UInt32:  return sizeof(std::uint32_t);
+            case havSeriLiteValueType::Int64:
+            case havSeriLiteValueType::UInt64:
+            case havSeriLiteValueType::Double:  return sizeof(std::uint64_t);
+            default:                            return 0;
+        }
+    }
+
+    template<typename T>
+    struct havSeriLiteTypedArrayTraits;
+
+    template<> struct havSeriLiteTypedArrayTraits<std::int32_t> { static constexpr havSeriLiteValueType ElementType = havSeriLiteValueType::Int32; };
+    template<> struct havSeriLiteTypedArrayTraits<std::uint32_t> { static constexpr havSeriLiteValueType ElementType = havSeriLiteValueType::UInt32; };
+    template<> struct havSeriLiteTypedArrayTraits<std::int64_t> { static constexpr havSeriLiteValueType ElementType = havSeriLiteValueType::Int64; };
+    template<> struct havSeriLiteTypedArrayTraits<std::uint64_t> { static constexpr havSeriLiteValueType ElementType = havSeriLiteValueType::UInt64; };
+    template<> struct havSeriLiteTypedArrayTraits<double> { static constexpr havSeriLiteValueType ElementType = havSeriLiteValueType::Double; };
+
+    inline std::size_t GetTypedArrayElementSize(havSeriLiteValueType elementType)
+    {
+        switch (elementType)
+        {
+            case havSeriLiteValueType::Int32:
+            case havSeriLiteValueType::UInt32: return sizeof(std::uint32_t);
+            case havSeriLiteValueType::Int64:
+            case havSeriLiteValueType::UInt64:
+            case havSeriLiteValueType::Double: return sizeof(std::uint64_t);
+            default:                           return 0;
+        }
+    }
+
+    // Note: Lightweight counterpart of "havSeriLiteValue" whose strings are views into the reader's input instead of owned copies.
+    struct havSeriLiteValueView
+    {
+        std::int32_t mDepthLevel = 0;
+        havSeriLiteValueType mType;
+        std::variant<std::string_view, havSeriLiteContainerData, havSeriLiteTypedArrayData, havSeriLiteRecordData, std::uint64_t, std::int64_t, double, std::uint32_t, std::int32_t, std::nullptr_t, bool> mData;
+        // Note: Id of a dictionary string, which is equal for equal strings of the same input.
+        std::uint32_t mStringId = NoStringId;
+
+        static constexpr std::uint32_t NoStringId = static_cast<std::uint32_t>(-1);
+
+        explicit havSeriLiteValueView(std::nullptr_t value, havSeriLiteValueType valueType) : mType(valueType), mData(value) {}
+
+        template<typename T>
+        explicit havSeriLiteValueView(havSeriLiteValueType valueType, T value) : mType(valueType), mData(std::in_place_type<T>, value) {}
     };
 
     struct havSeriLiteValue
@@ -122,7 +453,8 @@ namespace havSeriLite
 
         std::int32_t mDepthLevel = 0;
         havSeriLiteValueType mType;
-        std::variant<havSeriLiteStringData, std::uint64_t, std::int64_t, double, std::uint32_t, std::int32_t, std::nullptr_t, bool> mData;
+        std::variant<havSeriLiteStringData, havSeriLiteContainerData, havSeriLiteTypedArrayData, havSeriLiteRecordData, std::uint64_t, std::int64_t, double, std::uint32_t, std::int32_t, std::nullptr_t, bool> mData;
+        std::uint32_t mStringId = havSeriLiteValueView::NoStringId;
 
         explicit havSeriLiteValue(std::nullptr_t value, havSeriLiteValueType valueType) : mType(valueType), mData(value) {}
 
@@ -137,6 +469,21 @@ namespace havSeriLite
         explicit havSeriLiteValue(double value) : mType(havSeriLiteValueType::Double), mData(value) {}
 
         explicit havSeriLiteValue(const std::string& value) : mType(havSeriLiteValueType::String), mData(havSeriLiteStringData { value } ) {}
+        explicit havSeriLiteValue(std::string&& value) : mType(havSeriLiteValueType::String), mData(havSeriLiteStringData { std::move(value) } ) {}
+
+        explicit havSeriLiteValue(const havSeriLiteValueView& view) : mDepthLevel(view.mDepthLevel), mType(view.mType), mData(nullptr), mStringId(view.mStringId)
+        {
+            std::visit([this](const auto& data) {
+                if constexpr (std::is_same_v<std::decay_t<decltype(data)>, std::string_view>)
+                {
+                    mData = havSeriLiteStringData { std::string { data } };
+                }
+                else
+                {
+                    mData = data;
+                }
+            }, view.mData);
+        }
     };
 
 #ifdef _WIN32
@@ -157,367 +504,572 @@ namespace havSeriLite
     }
 #endif
 
-    class havSeriLiteWriter
+    class havSeriLiteMappedFile
     {
     public:
-        explicit havSeriLiteWriter(const std::string& fileName) : mFileStream(nullptr, std::fclose)
+        havSeriLiteMappedFile() = default;
+
+        ~havSeriLiteMappedFile()
         {
-            if (WriteFile(fileName) == false)
-            {
-                throw std::runtime_error("Unable to write file: " + fileName);
-            }
+            Close();
         }
 
-        ~havSeriLiteWriter() = default;
+        havSeriLiteMappedFile(const havSeriLiteMappedFile&) = delete;
+        havSeriLiteMappedFile& operator=(const havSeriLiteMappedFile&) = delete;
 
-        void WriteValue(havSeriLiteValue value)
+        havSeriLiteMappedFile(havSeriLiteMappedFile&& other) noexcept
         {
-            std::uint8_t type = static_cast<std::underlying_type_t<havSeriLiteValueType>>(value.mType);
-            std::fwrite(&type, sizeof(std::uint8_t), 1, mFileStream.get());
+            *this = std::move(other);
+        }
 
-            switch (value.mType)
+        havSeriLiteMappedFile& operator=(havSeriLiteMappedFile&& other) noexcept
+        {
+            if (this != &other)
             {
-                case havSeriLiteValueType::Boolean: std::fwrite(&std::get<bool>(value.mData), sizeof(bool), 1, mFileStream.get()); break;
-                case havSeriLiteValueType::Int32:   std::fwrite(&std::get<std::int32_t>(value.mData), sizeof(std::int32_t), 1, mFileStream.get()); break;
-                case havSeriLiteValueType::UInt32:  std::fwrite(&std::get<std::uint32_t>(value.mData), sizeof(std::uint32_t), 1, mFileStream.get()); break;
-                case havSeriLiteValueType::Int64:   std::fwrite(&std::get<std::int64_t>(value.mData), sizeof(std::int64_t), 1, mFileStream.get()); break;
-                case havSeriLiteValueType::UInt64:  std::fwrite(&std::get<std::uint64_t>(value.mData), sizeof(std::uint64_t), 1, mFileStream.get()); break;
-                case havSeriLiteValueType::Double:  std::fwrite(&std::get<double>(value.mData), sizeof(double), 1, mFileStream.get()); break;
-                case havSeriLiteValueType::String:
-                    {
-                        const havSeriLiteValue::havSeriLiteStringData& stringData = std::get<havSeriLiteValue::havSeriLiteStringData>(value.mData);
-                        std::uint32_t stringSize = stringData.GetSize();
-                        std::fwrite(&stringSize, sizeof(std::uint32_t), 1, mFileStream.get());
-                        std::fwrite(stringData.mValue.data(), stringData.GetSize(), 1, mFileStream.get());
-                    }
-                    break;
-                default: break;
+                Close();
+                std::swap(mData, other.mData);
+                std::swap(mSize, other.mSize);
+#ifdef _WIN32
+                std::swap(mFileHandle, other.mFileHandle);
+                std::swap(mMappingHandle, other.mMappingHandle);
+#endif
             }
-        }
 
-        inline void WriteBool(bool value) { WriteValue(havSeriLiteValue { value }); }
-        inline void WriteInt32(std::int32_t value) { WriteValue(havSeriLiteValue { value }); }
-        inline void WriteUInt32(std::uint32_t value) { WriteValue(havSeriLiteValue { value }); }
-        inline void WriteInt64(std::int64_t value) { WriteValue(havSeriLiteValue { value }); }
-        inline void WriteUInt64(std::uint64_t value) { WriteValue(havSeriLiteValue { value }); }
-        inline void WriteDouble(double value) { WriteValue(havSeriLiteValue { value }); }
-        inline void WriteString(const std::string& value) { WriteValue(havSeriLiteValue { value }); }
-        inline void WriteArray() { WriteValue(havSeriLiteValue { nullptr, havSeriLiteValueType::Array }); }
-        inline void WriteObject() { WriteValue(havSeriLiteValue { nullptr, havSeriLiteValueType::Object }); }
-        // Note: Marks the end of the current object or array in the serialized structure.
-        inline void WriteClose() { WriteValue(havSeriLiteValue { nullptr, havSeriLiteValueType::Close }); }
-        inline void WriteCloseArray() { WriteClose(); }
-        inline void WriteCloseObject() { WriteClose(); }
+            return *this;
+        }
 
-        bool WriteFile(const std::string& fileName)
+        bool Open(const std::string& fileName)
         {
+            Close();
+
 #ifdef _WIN32
-            std::unique_ptr<std::FILE, decltype(&std::fclose)> fileStream(_wfopen(&ConvertStringToWString(fileName)[0], L"wb"), std::fclose);
-#else
-            std::unique_ptr<std::FILE, decltype(&std::fclose)> fileStream(std::fopen(fileName.c_str(), "wb"), std::fclose);
-#endif
+            mFileHandle = CreateFileW(&ConvertStringToWString(fileName)[0], GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
 
-            if (fileStream == nullptr)
+            if (mFileHandle == INVALID_HANDLE_VALUE)
             {
-                std::cerr << "Unable to write file: " << fileName << std::endl;
                 return false;
             }
 
-            mFileStream = std::move(fileStream);
+            LARGE_INTEGER fileSize;
 
-            return true;
-        }
+            if (GetFileSizeEx(mFileHandle, &fileSize) == FALSE)
+            {
+                Close();
+                return false;
+            }
 
-        void CloseFile()
-        {
-            mFileStream.reset(nullptr);
-        }
+            mSize = static_cast<std::size_t>(fileSize.QuadPart);
 
-    private:
-        std::unique_ptr<std::FILE, decltype(&std::fclose)> mFileStream;
-    };
+            // Note: Empty files cannot be mapped, but are still valid (empty) inputs.
+            if (mSize == 0)
+            {
+                return true;
+            }
 
-    class havSeriLiteReader
-    {
-    public:
-        explicit havSeriLiteReader(const std::string& fileName) : mSize(0), mIndex(0), mDepthLevel(0)
-        {
-            if (ReadFile(fileName) == false)
+            mMappingHandle = CreateFileMappingW(mFileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+
+            if (mMappingHandle == nullptr)
             {
-                throw std::runtime_error("Unable to read file: " + fileName);
+                Close();
+                return false;
             }
-        }
 
-        ~havSeriLiteReader() = default;
+            mData = static_cast<const char*>(MapViewOfFile(mMappingHandle, FILE_MAP_READ, 0, 0, 0));
+#else
+            int fileDescriptor = ::open(fileName.c_str(), O_RDONLY);
 
-        inline bool ValidityCheck(void* destination, std::uint32_t size)
-        {
-            if (size == 0 || mIndex + size > mSize)
+            if (fileDescriptor == -1)
             {
                 return false;
             }
 
-            if (destination != nullptr)
+            struct stat fileStatus;
+
+            if (::fstat(fileDescriptor, &fileStatus) != 0)
             {
-                std::copy(reinterpret_cast<const char*>(&mData[mIndex]), reinterpret_cast<const char*>(&mData[mIndex + size]), static_cast<char*>(destination));
+                ::close(fileDescriptor);
+                return false;
             }
 
-            mIndex += size;
+            mSize = static_cast<std::size_t>(fileStatus.st_size);
 
-            return true;
-        }
+            // Note: Empty files cannot be mapped, but are still valid (empty) inputs.
+            if (mSize == 0)
+            {
+                ::close(fileDescriptor);
+                return true;
+            }
 
-        template<typename T>
-        inline std::optional<T> TryRead(const havSeriLiteValue& value, havSeriLiteValueType expectedType)
-        {
-            if (value.mType == expectedType)
+            void* mapping = ::mmap(nullptr, mSize, PROT_READ, MAP_PRIVATE, fileDescriptor, 0);
+
+            // Note: The mapping stays valid after the descriptor is closed.
+            ::close(fileDescriptor);
+
+            if (mapping != MAP_FAILED)
             {
-                if (auto* ptr = std::get_if<T>(&value.mData))
-                {
-                    return *ptr;
-                }
+                ::posix_madvise(mapping, mSize, POSIX_MADV_SEQUENTIAL);
+                mData = static_cast<const char*>(mapping);
             }
+#endif
 
-            return std::nullopt;
-        }
+            if (mData == nullptr)
+            {
+                Close();
+                return false;
+            }
 
-        inline std::optional<bool> TryReadBool(const havSeriLiteValue& value) { return TryRead<bool>(value, havSeriLiteValueType::Boolean); }
-        inline std::optional<std::int32_t> TryReadInt32(const havSeriLiteValue& value) { return TryRead<std::int32_t>(value, havSeriLiteValueType::Int32); }
-        inline std::optional<std::uint32_t> TryReadUInt32(const havSeriLiteValue& value) { return TryRead<std::uint32_t>(value, havSeriLiteValueType::UInt32); }
-        inline std::optional<std::int64_t> TryReadInt64(const havSeriLiteValue& value) { return TryRead<std::int64_t>(value, havSeriLiteValueType::Int64); }
-        inline std::optional<std::uint64_t> TryReadUInt64(const havSeriLiteValue& value) { return TryRead<std::uint64_t>(value, havSeriLiteValueType::UInt64); }
-        inline std::optional<double> TryReadDouble(const havSeriLiteValue& value) { return TryRead<double>(value, havSeriLiteValueType::Double); }
-        inline std::optional<std::string> TryReadString(const havSeriLiteValue& value)
-        {
-            auto result = TryRead<havSeriLiteValue::havSeriLiteStringData>(value, havSeriLiteValueType::String);
-            return result ? std::optional<std::string>(result->mValue) : std::nullopt;
+            return true;
         }
 
-        havSeriLiteValue ReadValue()
+        void Close()
         {
-            havSeriLiteValue result { nullptr, havSeriLiteValueType::Null };
+#ifdef _WIN32
+            if (mData != nullptr)
+            {
+                UnmapViewOfFile(mData);
+            }
 
-            bool valid = ValidityCheck(&result.mType, sizeof(std::uint8_t));
+            if (mMappingHandle != nullptr)
+            {
+                CloseHandle(mMappingHandle);
+                mMappingHandle = nullptr;
+            }
 
-            switch (result.mType)
+            if (mFileHandle != INVALID_HANDLE_VALUE)
             {
-                case havSeriLiteValueType::Close:
-                    --mDepthLevel;
-                    break;
+                CloseHandle(mFileHandle);
+                mFileHandle = INVALID_HANDLE_VALUE;
+            }
+#else
+            if (mData != nullptr)
+            {
+                ::munmap(const_cast<char*>(mData), mSize);
+            }
+#endif
 
-                case havSeriLiteValueType::Boolean:
-                    result = havSeriLiteValue { false };
-                    valid &= ValidityCheck(&std::get<bool>(result.mData), sizeof(bool));
-                    break;
+            mData = nullptr;
+            mSize = 0;
+        }
 
-                case havSeriLiteValueType::Int32:
-                    result = havSeriLiteValue { std::int32_t { 0 } };
-                    valid &= ValidityCheck(&std::get<std::int32_t>(result.mData), sizeof(std::int32_t));
-                    break;
+        inline const char* GetData() const { return mData; }
+        inline std::size_t GetSize() const { return mSize; }
 
-                case havSeriLiteValueType::UInt32:
-                    result = havSeriLiteValue { std::uint32_t { 0 } };
-                    valid &= ValidityCheck(&std::get<std::uint32_t>(result.mData), sizeof(std::uint32_t));
-                    break;
+    private:
+        const char* mData = nullptr;
+        std::size_t mSize = 0;
+#ifdef _WIN32
+        HANDLE mFileHandle = INVALID_HANDLE_VALUE;
+        HANDLE mMappingHandle = nullptr;
+#endif
+    };
 
-                case havSeriLiteValueType::Int64:
-                    result = havSeriLiteValue { std::int64_t { 0 } };
-                    valid &= ValidityCheck(&std::get<std::int64_t>(result.mData), sizeof(std::int64_t));
-                    break;
+    struct havSeriLiteBufferView
+    {
+        const char* mData;
+        std::size_t mSize;
+    };
 
-                case havSeriLiteValueType::UInt64:
-                    result = havSeriLiteValue { std::uint64_t { 0 } };
-                    valid &= ValidityCheck(&std::get<std::uint64_t>(result.mData), sizeof(std::uint64_t));
-                    break;
+    // Note: Per-thread free list of byte buffers. Readers and writers take their buffers from it and hand them back when they are
+    // destroyed, so instances created per message reuse the memory of earlier ones instead of allocating it again. The pool keeps
+    // no buffers until "SetMaxBuffers" is called on the thread, and buffers larger than "SetMaxBufferCapacity" are always freed.
+    class havSeriLiteBufferPool
+    {
+    public:
+        static std::vector<char> Acquire(std::size_t capacity = 0)
+        {
+            havSeriLiteBufferPoolState& state = GetState();
+            std::vector<char> buffer;
 
-                case havSeriLiteValueType::Double:
-                    result = havSeriLiteValue { double { 0.0 } };
-                    valid &= ValidityCheck(&std::get<double>(result.mData), sizeof(double));
-                    break;
+            if (state.mBuffers.empty() == false)
+            {
+                buffer = std::move(state.mBuffers.back());
+                state.mBuffers.pop_back();
+            }
 
-                case havSeriLiteValueType::String:
-                    {
-                        result = havSeriLiteValue { std::string { "" } };
-                        havSeriLiteValue::havSeriLiteStringData& stringData = std::get<havSeriLiteValue::havSeriLiteStringData>(result.mData);
-                        std::uint32_t stringSize = 0;
-                        valid &= ValidityCheck(&stringSize, sizeof(std::uint32_t));
-                        if (valid == true)
-                        {
-                            stringData.mValue.resize(stringSize);
-                            valid &= ValidityCheck(stringData.mValue.data(), stringSize);
-                        }
-                    }
-                    break;
+            buffer.reserve(capacity);
 
-                case havSeriLiteValueType::Array:
-                case havSeriLiteValueType::Object:
-                    result.mDepthLevel = ++mDepthLevel;
-                    break;
+            return buffer;
+        }
 
-                default:
-                    valid &= false;
-                    break;
-            }
+        static void Release(std::vector<char> buffer)
+        {
+            havSeriLiteBufferPoolState& state = GetState();
 
-            if (valid == false)
+            if (buffer.capacity() == 0 || buffer.capacity() > state.mMaxBufferCapacity || state.mBuffers.size() >= state.mMaxBuffers)
             {
-                return havSeriLiteValue { nullptr, havSeriLiteValueType::Null };
+                return;
             }
 
-            return result;
+            buffer.clear();
+            state.mBuffers.push_back(std::move(buffer));
         }
 
-        inline bool ArrayIterator(const std::int32_t& depthLevel, havSeriLiteValue& value)
+        static void SetMaxBuffers(std::size_t maxBuffers)
         {
-            return Iterator(depthLevel, value);
+            havSeriLiteBufferPoolState& state = GetState();
+            state.mMaxBuffers = maxBuffers;
+
+            if (state.mBuffers.size() > maxBuffers)
+            {
+                state.mBuffers.resize(maxBuffers);
+            }
+
+            state.mBuffers.reserve(maxBuffers);
         }
 
-        inline bool ObjectIterator(const std::int32_t& depthLevel, havSeriLiteValue& key, havSeriLiteValue& value)
+        static inline void SetMaxBufferCapacity(std::size_t maxBufferCapacity) { GetState().mMaxBufferCapacity = maxBufferCapacity; }
+
+        static inline std::size_t GetNumOfBuffers() { return GetState().mBuffers.size(); }
+
+    private:
+        struct havSeriLiteBufferPoolState
         {
-            return Iterator(depthLevel, value, key);
-        }
+            std::vector<std::vector<char>> mBuffers;
+            std::size_t mMaxBuffers = 0;
+            std::size_t mMaxBufferCapacity = 16 * 1024 * 1024;
+        };
 
-        bool Iterator(const std::int32_t& depthLevel, havSeriLiteValue& value, std::optional<std::reference_wrapper<havSeriLiteValue>> key = std::nullopt)
+        static havSeriLiteBufferPoolState& GetState()
         {
-            havSeriLiteValue tempValue = havSeriLiteValue { nullptr, havSeriLiteValueType::Close };
+            thread_local havSeriLiteBufferPoolState state;
+            return state;
+        }
+    };
 
-            while (tempValue.mType != havSeriLiteValueType::Null && mDepthLevel != depthLevel)
-            {
-                tempValue = ReadValue();
-            }
+    class havSeriLiteSink
+    {
+    public:
+        virtual ~havSeriLiteSink() = default;
 
-            if (key.has_value() == true)
-            {
-                key->get() = ReadValue();
+        virtual bool Write(const char* data, std::size_t size) = 0;
 
-                if (key->get().mType == havSeriLiteValueType::Close)
+        // Note: Sinks that support vectored I/O should override this to write all buffers with a single call.
+        virtual bool WriteVector(const havSeriLiteBufferView* buffers, std::size_t count)
+        {
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                if (buffers[i].mSize > 0 && Write(buffers[i].mData, buffers[i].mSize) == false)
                 {
                     return false;
                 }
             }
 
-            value = ReadValue();
+            return true;
+        }
+
+        virtual bool Flush() { return true; }
+
+        // Note: Sinks that can overwrite output they already received (e.g. regular files) should override both, so the writer patches
+        // the headers of sized containers in place instead of holding the containers in memory until they are closed.
+        virtual bool CanWriteBack() const { return false; }
+
+        // Note: Overwrites "size" bytes starting "distance" bytes before the end of the output written so far.
+        virtual bool WriteBack([[maybe_unused]] std::uint64_t distance, [[maybe_unused]] const char* data, [[maybe_unused]] std::size_t size) { return false; }
+    };
+
+    class havSeriLiteMemorySink : public havSeriLiteSink
+    {
+    public:
+        havSeriLiteMemorySink() : mTarget(&mData) {}
+
+        // Note: Appends to a caller-owned buffer (e.g. a network send buffer), which must outlive the sink.
+        explicit havSeriLiteMemorySink(std::vector<char>& target) : mTarget(&target) {}
+
+        havSeriLiteMemorySink(const havSeriLiteMemorySink&) = delete;
+        havSeriLiteMemorySink& operator=(const havSeriLiteMemorySink&) = delete;
 
-            if (key.has_value() == false)
+        bool Write(const char* data, std::size_t size) override
+        {
+            mTarget->insert(mTarget->end(), data, data + size);
+            return true;
+        }
+
+        inline const std::vector<char>& GetData() const { return *mTarget; }
+        inline void Clear() { mTarget->clear(); }
+
+        // Note: Appends to another caller-owned buffer from now on.
+        inline void SetTarget(std::vector<char>& target) { mTarget = &target; }
+
+    private:
+        std::vector<char> mData;
+        std::vector<char>* mTarget;
+    };
+
+    class havSeriLiteFileSink : public havSeriLiteSink
+    {
+    public:
+        havSeriLiteFileSink() : mFileStream(nullptr, std::fclose) {}
+
+        bool Open(const std::string& fileName)
+        {
+#ifdef _WIN32
+            std::unique_ptr<std::FILE, decltype(&std::fclose)> fileStream(_wfopen(&ConvertStringToWString(fileName)[0], L"wb"), std::fclose);
+#else
+            std::unique_ptr<std::FILE, decltype(&std::fclose)> fileStream(std::fopen(fileName.c_str(), "wb"), std::fclose);
+#endif
+
+            if (fileStream == nullptr)
             {
-                return value.mType != havSeriLiteValueType::Close;
+                return false;
             }
 
+            // Note: The writer already hands over large blocks, so the stdio buffer would only add a copy.
+            std::setvbuf(fileStream.get(), nullptr, _IONBF, 0);
+
+            // Note: Pipes and character devices opened by name cannot be written back to.
+#ifdef _WIN32
+            mSeekable = _ftelli64(fileStream.get()) != -1;
+#else
+            mSeekable = ftello(fileStream.get()) != static_cast<off_t>(-1);
+#endif
+
+            mFileStream = std::move(fileStream);
+
             return true;
         }
 
-        void OutputValueType(const havSeriLiteValue& value)
+        bool Write(const char* data, std::size_t size) override
         {
-            switch (value.mType)
+            return mFileStream != nullptr && std::fwrite(data, sizeof(char), size, mFileStream.get()) == size;
+        }
+
+        bool Flush() override
+        {
+            return mFileStream != nullptr && std::fflush(mFileStream.get()) == 0;
+        }
+
+        bool CanWriteBack() const override { return mFileStream != nullptr && mSeekable == true; }
+
+        bool WriteBack(std::uint64_t distance, const char* data, std::size_t size) override
+        {
+            if (CanWriteBack() == false || size > distance || distance > static_cast<std::uint64_t>(std::numeric_limits<long long>::max()))
             {
-                case havSeriLiteValueType::Boolean: std::cout << (std::get<bool>(value.mData) ? "true" : "false"); break;
-                case havSeriLiteValueType::Int32:   std::cout << std::get<std::int32_t>(value.mData); break;
-                case havSeriLiteValueType::UInt32:  std::cout << std::get<std::uint32_t>(value.mData); break;
-                case havSeriLiteValueType::Int64:   std::cout << std::get<std::int64_t>(value.mData); break;
-                case havSeriLiteValueType::UInt64:  std::cout << std::get<std::uint64_t>(value.mData); break;
-                case havSeriLiteValueType::Double:  std::cout << std::fixed << std::setprecision(15) << std::get<double>(value.mData); break;
-                case havSeriLiteValueType::String:
+                return false;
+            }
+
+#ifdef _WIN32
+            if (_fseeki64(mFileStream.get(), -static_cast<long long>(distance), SEEK_END) != 0)
+            {
+                return false;
+            }
+
+            const bool result = std::fwrite(data, sizeof(char), size, mFileStream.get()) == size;
+
+            return _fseeki64(mFileStream.get(), 0, SEEK_END) == 0 && result == true;
+#else
+            if (fseeko(mFileStream.get(), -static_cast<off_t>(distance), SEEK_END) != 0)
+            {
+                return false;
+            }
+
+            const bool result = std::fwrite(data, sizeof(char), size, mFileStream.get()) == size;
+
+            return fseeko(mFileStream.get(), 0, SEEK_END) == 0 && result == true;
+#endif
+        }
+
+    private:
+        std::unique_ptr<std::FILE, decltype(&std::fclose)> mFileStream;
+        bool mSeekable = false;
+    };
+
+    // Note: Writes to a standard output stream such as "std::cout" or a "std::ofstream", which must outlive the sink.
+    class havSeriLiteOstreamSink : public havSeriLiteSink
+    {
+    public:
+        explicit havSeriLiteOstreamSink(std::ostream& stream) : mStream(stream) {}
+
+        bool Write(const char* data, std::size_t size) override
+        {
+            mStream.write(data, static_cast<std::streamsize>(size));
+            return mStream.good();
+        }
+
+        bool Flush() override
+        {
+            mStream.flush();
+            return mStream.good();
+        }
+
+    private:
+        std::ostream& mStream;
+    };
+
+#ifndef _WIN32
+    class havSeriLiteFdSink : public havSeriLiteSink
+    {
+    public:
+        // Note: Set "ownsFileDescriptor" to "true" to close the descriptor when the sink is destroyed.
+        explicit havSeriLiteFdSink(int fileDescriptor, bool ownsFileDescriptor = false) : mFileDescriptor(fileDescriptor), mOwnsFileDescriptor(ownsFileDescriptor)
+        {
+            // Note: Pipes and sockets cannot seek, and positioned writes to descriptors opened for appending may land at the end.
+            const int statusFlags = ::fcntl(mFileDescriptor, F_GETFL);
+            mSeekable = statusFlags != -1 && (statusFlags & O_APPEND) == 0 && ::lseek(mFileDescriptor, 0, SEEK_CUR) != static_cast<off_t>(-1);
+        }
+
+        ~havSeriLiteFdSink() override
+        {
+            if (mOwnsFileDescriptor == true && mFileDescriptor != -1)
+            {
+                ::close(mFileDescriptor);
+            }
+        }
+
+        havSeriLiteFdSink(const havSeriLiteFdSink&) = delete;
+        havSeriLiteFdSink& operator=(const havSeriLiteFdSink&) = delete;
+
+        bool Write(const char* data, std::size_t size) override
+        {
+            while (size > 0)
+            {
+                ssize_t written = ::write(mFileDescriptor, data, size);
+
+                if (written < 0)
+                {
+                    if (errno == EINTR)
                     {
-                        const auto& stringData = std::get<havSeriLiteValue::havSeriLiteStringData>(value.mData);
-                        std::cout << '"';
-                        for (const char& character : stringData.mValue)
-                        {
-                            switch (character)
-                            {
-                                case '"':  std::cout << "\\\""; break;
-                                case '\\': std::cout << "\\\\"; break;
-                                case '\b': std::cout << "\\b"; break;
-                                case '\f': std::cout << "\\f"; break;
-                                case '\n': std::cout << "\\n"; break;
-                                case '\r': std::cout << "\\r"; break;
-                                case '\t': std::cout << "\\t"; break;
-                                case '\v': std::cout << "\\v"; break;
-                                default:
-                                    if (static_cast<unsigned char>(character) < 0x20)
-                                    {
-                                        std::cout << "\\u" << std::hex << std::setw(4) << std::setfill('0') << static_cast<int>(static_cast<unsigned char>(character));
-                                    }
-                                    else
-                                    {
-                                        std::cout << character;
-                                    }
-                            }
-                        }
-                        std::cout << '"';
+                        continue;
                     }
-                    break;
-                case havSeriLiteValueType::Null:    std::cerr << "Unsupported or null value type!" << std::endl; break;
-                default:                            std::cerr << "Unsupported value type!" << std::endl; break;
+
+                    return false;
+                }
+
+                data += written;
+                size -= static_cast<std::size_t>(written);
             }
+
+            return true;
         }
 
-        void OutputComplexType(havSeriLiteValue value, std::int32_t depthLevel)
+        bool WriteVector(const havSeriLiteBufferView* buffers, std::size_t count) override
         {
-            auto OutputIndent = [](std::int32_t depthLvl) {
-                std::cout << std::string(depthLvl * 4, ' ');
-            };
+            constexpr std::size_t MaxVectors = 64;
+            struct iovec vectors[MaxVectors];
 
-            const std::int32_t nextDepth = depthLevel + 1;
-            havSeriLiteValue currentKey { nullptr, havSeriLiteValueType::Null };
-            havSeriLiteValue currentValue { nullptr, havSeriLiteValueType::Null };
-            std::uint32_t elementIndex = 0;
+            while (count > 0)
+            {
+                std::size_t numOfVectors = 0;
 
-            auto OutputSeparator = [&]() {
-                if (++elementIndex > 1)
+                for (; numOfVectors < count && numOfVectors < MaxVectors; ++numOfVectors)
                 {
-                    std::cout << "," << std::endl;
+                    vectors[numOfVectors].iov_base = const_cast<char*>(buffers[numOfVectors].mData);
+                    vectors[numOfVectors].iov_len = buffers[numOfVectors].mSize;
                 }
-            };
 
-            if (value.mType == havSeriLiteValueType::Array)
-            {
-                std::cout << "[" << std::endl;
-                while (ArrayIterator(value.mDepthLevel, currentValue) == true)
+                ssize_t written = ::writev(mFileDescriptor, vectors, static_cast<int>(numOfVectors));
+
+                if (written < 0)
+                {
+                    if (errno == EINTR)
+                    {
+                        continue;
+                    }
+
+                    return false;
+                }
+
+                // Note: Skip the fully written buffers and finish a partially written one with plain writes.
+                std::size_t remaining = static_cast<std::size_t>(written);
+
+                while (count > 0 && remaining >= buffers->mSize)
                 {
-                    OutputSeparator();
-                    OutputIndent(nextDepth);
-                    OutputValue(currentValue, nextDepth);
+                    remaining -= buffers->mSize;
+                    ++buffers;
+                    --count;
                 }
-                std::cout << std::endl;
-                OutputIndent(depthLevel);
-                std::cout << "]";
-            }
-            else if (value.mType == havSeriLiteValueType::Object)
-            {
-                std::cout << "{" << std::endl;
-                while (ObjectIterator(value.mDepthLevel, currentKey, currentValue) == true)
+
+                if (count > 0 && remaining > 0)
                 {
-                    OutputSeparator();
-                    OutputIndent(nextDepth);
-                    OutputValue(currentKey, nextDepth);
-                    std::cout << ": ";
-                    OutputValue(currentValue, nextDepth);
+                    if (Write(buffers->mData + remaining, buffers->mSize - remaining) == false)
+                    {
+                        return false;
+                    }
+
+                    ++buffers;
+                    --count;
                 }
-                std::cout << std::endl;
-                OutputIndent(depthLevel);
-                std::cout << "}";
             }
+
+            return true;
         }
 
-        // Note: Set "initialState" to "true" to reset the reader's state and start outputting from the beginning.
-        void OutputValue(havSeriLiteValue value, std::int32_t depthLevel, bool initialState = false)
+        bool CanWriteBack() const override { return mSeekable; }
+
+        bool WriteBack(std::uint64_t distance, const char* data, std::size_t size) override
         {
-            if (initialState == true)
+            const off_t end = mSeekable == true ? ::lseek(mFileDescriptor, 0, SEEK_CUR) : static_cast<off_t>(-1);
+
+            if (end == static_cast<off_t>(-1) || size > distance || distance > static_cast<std::uint64_t>(end))
             {
-                mIndex = 0;
+                return false;
             }
 
-            if (value.mType == havSeriLiteValueType::Array || value.mType == havSeriLiteValueType::Object)
+            off_t offset = end - static_cast<off_t>(distance);
+
+            while (size > 0)
             {
-                OutputComplexType(value, depthLevel);
+                ssize_t written = ::pwrite(mFileDescriptor, data, size, offset);
+
+                if (written < 0)
+                {
+                    if (errno == EINTR)
+                    {
+                        continue;
+                    }
+
+                    return false;
+                }
+
+                data += written;
+                size -= static_cast<std::size_t>(written);
+                offset += written;
             }
-            else
+
+            return true;
+        }
+
+    private:
+        int mFileDescriptor;
+        bool mOwnsFileDescriptor;
+        bool mSeekable;
+    };
+#endif
+
+    class havSeriLiteSource
+    {
+    public:
+        virtual ~havSeriLiteSource() = default;
+
+        // Note: Returns the number of bytes read, which is zero at the end of the input or on an error.
+        virtual std::size_t Read(char* data, std::size_t size) = 0;
+
+        // Note: Sources that support seeking should override this to skip bytes without reading them.
+        virtual bool Skip(std::uint64_t size)
+        {
+            char scratch[4096];
+
+            while (size > 0)
             {
-                OutputValueType(value);
+                const std::size_t numOfBytes = Read(scratch, static_cast<std::size_t>(std::min<std::uint64_t>(size, sizeof(scratch))));
+
+                if (numOfBytes == 0)
+                {
+                    return false;
+                }
+
+                size -= numOfBytes;
             }
+
+            return true;
         }
+    };
 
-        bool ReadFile(const std::string& fileName)
+    class havSeriLiteFileSource : public havSeriLiteSource
+    {
+    public:
+        havSeriLiteFileSource() : mFileStream(nullptr, std::fclose) {}
+
+        bool Open(const std::string& fileName)
         {
 #ifdef _WIN32
             std::unique_ptr<std::FILE, decltype(&std::fclose)> fileStream(_wfopen(&ConvertStringToWString(fileName)[0], L"rb"), std::fclose);
@@ -527,51 +1079,6766 @@ namespace havSeriLite
 
             if (fileStream == nullptr)
             {
-                std::cerr << "Unable to read file: " << fileName << "!" << std::endl;
                 return false;
             }
 
-            mData.clear();
+            // Note: The reader already requests whole windows, so the stdio buffer would only add a copy.
+            std::setvbuf(fileStream.get(), nullptr, _IONBF, 0);
 
-            if (std::fseek(fileStream.get(), 0, SEEK_END) == 0)
+            mFileStream = std::move(fileStream);
+
+            return true;
+        }
+
+        std::size_t Read(char* data, std::size_t size) override
+        {
+            return mFileStream != nullptr ? std::fread(data, sizeof(char), size, mFileStream.get()) : 0;
+        }
+
+        bool Skip(std::uint64_t size) override
+        {
+#ifdef _WIN32
+            if (mFileStream != nullptr && size <= static_cast<std::uint64_t>(std::numeric_limits<long long>::max()) && _fseeki64(mFileStream.get(), static_cast<long long>(size), SEEK_CUR) == 0)
+#else
+            if (mFileStream != nullptr && size <= static_cast<std::uint64_t>(std::numeric_limits<off_t>::max()) && fseeko(mFileStream.get(), static_cast<off_t>(size), SEEK_CUR) == 0)
+#endif
             {
-                long fileSize = std::ftell(fileStream.get());
-                if (fileSize > 0)
-                {
-                    mData.reserve(static_cast<std::size_t>(fileSize));
-                }
-                else
-                {
-                    std::cerr << "Warning: Unable to determine file size, proceeding without reservation!" << std::endl;
-                }
-                std::fseek(fileStream.get(), 0, SEEK_SET);
+                return true;
             }
-            else
+
+            return havSeriLiteSource::Skip(size);
+        }
+
+        bool Rewind()
+        {
+            return mFileStream != nullptr && std::fseek(mFileStream.get(), 0, SEEK_SET) == 0;
+        }
+
+    private:
+        std::unique_ptr<std::FILE, decltype(&std::fclose)> mFileStream;
+    };
+
+#ifndef _WIN32
+    class havSeriLiteFdSource : public havSeriLiteSource
+    {
+    public:
+        // Note: Set "ownsFileDescriptor" to "true" to close the descriptor when the source is destroyed.
+        explicit havSeriLiteFdSource(int fileDescriptor, bool ownsFileDescriptor = false) : mFileDescriptor(fileDescriptor), mOwnsFileDescriptor(ownsFileDescriptor) {}
+
+        ~havSeriLiteFdSource() override
+        {
+            if (mOwnsFileDescriptor == true && mFileDescriptor != -1)
             {
-                std::cerr << "Error: Failed to seek to end of file, proceeding without reservation!" << std::endl;
+                ::close(mFileDescriptor);
             }
+        }
 
-            mSize = 0;
-            mIndex = 0;
-            mDepthLevel = 0;
+        havSeriLiteFdSource(const havSeriLiteFdSource&) = delete;
+        havSeriLiteFdSource& operator=(const havSeriLiteFdSource&) = delete;
 
-            char currentChar;
+        std::size_t Read(char* data, std::size_t size) override
+        {
+            while (true)
+            {
+                ssize_t numOfBytes = ::read(mFileDescriptor, data, size);
+
+                if (numOfBytes < 0)
+                {
+                    if (errno == EINTR)
+                    {
+                        continue;
+                    }
+
+                    return 0;
+                }
 
-            while (std::fread(&currentChar, sizeof(char), 1, fileStream.get()) > 0)
+                return static_cast<std::size_t>(numOfBytes);
+            }
+        }
+
+        bool Skip(std::uint64_t size) override
+        {
+            // Note: Pipes and sockets cannot seek, so they fall back to reading and discarding.
+            if (size <= static_cast<std::uint64_t>(std::numeric_limits<off_t>::max()) && ::lseek(mFileDescriptor, static_cast<off_t>(size), SEEK_CUR) != static_cast<off_t>(-1))
             {
-                mData.push_back(currentChar);
-                ++mSize;
+                return true;
             }
 
-            return true;
+            return havSeriLiteSource::Skip(size);
         }
 
     private:
-        std::vector<char> mData;
-        std::uint32_t mSize;
-        std::uint32_t mIndex;
-        std::int32_t mDepthLevel;
+        int mFileDescriptor;
+        bool mOwnsFileDescriptor;
     };
-}
+#endif
+
+    // Note: Layout of the output of "havSeriLiteBlockSink": a header, the blocks (each preceded by a block header), an empty end
+    // block, the block index and a footer. Every block is compressed on its own, so blocks can be decoded in any order.
+    struct havSeriLiteBlockFrame
+    {
+        static constexpr char Magic[4] = { 'H', 'S', 'L', 'B' };
+        static constexpr std::uint8_t Version = 1;
+        // Note: Magic, version, three reserved bytes and the block size.
+        static constexpr std::size_t HeaderSize = sizeof(Magic) + 4 + sizeof(std::uint32_t);
+        // Note: Stored size and uncompressed size. Blocks that did not compress are stored as they are, marked with "StoredFlag".
+        static constexpr std::size_t BlockHeaderSize = 2 * sizeof(std::uint32_t);
+        static constexpr std::uint32_t StoredFlag = 0x80000000u;
+        static constexpr std::size_t MaxBlockSize = 64 * 1024 * 1024;
+        // Note: Offset of the block header within the frame and offset of the block within the uncompressed data.
+        static constexpr std::size_t IndexEntrySize = 2 * sizeof(std::uint64_t);
+        // Note: Uncompressed size, number of blocks, offset of the block index and magic.
+        static constexpr std::size_t FooterSize = 3 * sizeof(std::uint64_t) + sizeof(Magic);
+    };
+
+    inline std::size_t GetMaxCompressedSize(std::size_t size)
+    {
+        return size + size / 255 + 16;
+    }
+
+    // Note: LZ77 codec in the style of LZ4: sequences of a token (literal and match length nibbles), literals and a 16-bit match
+    // offset. "output" must hold at least "GetMaxCompressedSize(size)" bytes. Returns the compressed size.
+    inline std::size_t CompressBlock(const char* input, std::size_t size, char* output)
+    {
+        constexpr std::size_t MinMatch = 4;
+        constexpr std::size_t HashBits = 12;
+        // Note: Matches stop this many bytes before the end, so the last sequence only holds literals.
+        constexpr std::size_t EndLiterals = 5;
+
+        const unsigned char* source = reinterpret_cast<const unsigned char*>(input);
+        unsigned char* destination = reinterpret_cast<unsigned char*>(output);
+        std::size_t outputIndex = 0;
+
+        auto Load32 = [source](std::size_t position) {
+            std::uint32_t value;
+            std::memcpy(&value, source + position, sizeof(value));
+            return value;
+        };
+
+        auto AppendLength = [&](std::size_t length) {
+            for (; length >= 255; length -= 255)
+            {
+                destination[outputIndex++] = 255;
+            }
+
+            destination[outputIndex++] = static_cast<unsigned char>(length);
+        };
+
+        auto AppendLiterals = [&](std::size_t literalStart, std::size_t literalLength, std::size_t matchLength) {
+            const std::size_t matchCode = matchLength - MinMatch;
+            destination[outputIndex++] = static_cast<unsigned char>((std::min<std::size_t>(literalLength, 15) << 4) | std::min<std::size_t>(matchCode, 15));
+
+            if (literalLength >= 15)
+            {
+                AppendLength(literalLength - 15);
+            }
+
+            if (literalLength > 0)
+            {
+                std::memcpy(destination + outputIndex, source + literalStart, literalLength);
+                outputIndex += literalLength;
+            }
+        };
+
+        std::uint32_t table[std::size_t(1) << HashBits] = {};
+        std::size_t anchor = 0;
+        std::size_t position = 0;
+
+        if (size > MinMatch + EndLiterals)
+        {
+            const std::size_t matchLimit = size - EndLiterals;
+
+            while (position + MinMatch <= matchLimit)
+            {
+                const std::uint32_t sequence = Load32(position);
+                const std::uint32_t hash = (sequence * 2654435761u) >> (32 - HashBits);
+                const std::size_t candidate = table[hash];
+                table[hash] = static_cast<std::uint32_t>(position);
+
+                if (candidate < position && position - candidate <= 0xFFFF && Load32(candidate) == sequence)
+                {
+                    std::size_t matchLength = MinMatch;
+
+                    while (position + matchLength < matchLimit && source[candidate + matchLength] == source[position + matchLength])
+                    {
+                        ++matchLength;
+                    }
+
+                    const std::size_t offset = position - candidate;
+
+                    AppendLiterals(anchor, position - anchor, matchLength);
+                    destination[outputIndex++] = static_cast<unsigned char>(offset & 0xFF);
+                    destination[outputIndex++] = static_cast<unsigned char>(offset >> 8);
+
+                    if (matchLength - MinMatch >= 15)
+                    {
+                        AppendLength(matchLength - MinMatch - 15);
+                    }
+
+                    position += matchLength;
+                    anchor = position;
+                }
+                else
+                {
+                    // Note: Steps through incompressible input faster the longer no match has been found.
+                    position += 1 + ((position - anchor) >> 6);
+                }
+            }
+        }
+
+        AppendLiterals(anchor, size - anchor, MinMatch);
+
+        return outputIndex;
+    }
+
+    // Note: Returns "false" unless "input" decompresses to exactly "outputSize" bytes. Never reads or writes out of bounds.
+    inline bool DecompressBlock(const char* input, std::size_t inputSize, char* output, std::size_t outputSize)
+    {
+        constexpr std::size_t MinMatch = 4;
+
+        const unsigned char* source = reinterpret_cast<const unsigned char*>(input);
+        unsigned char* destination = reinterpret_cast<unsigned char*>(output);
+        std::size_t inputIndex = 0;
+        std::size_t outputIndex = 0;
+
+        auto ReadLength = [&](std::size_t& length) {
+            unsigned char byte = 255;
+
+            while (byte == 255)
+            {
+                if (inputIndex == inputSize)
+                {
+                    return false;
+                }
+
+                byte = source[inputIndex++];
+                length += byte;
+            }
+
+            return true;
+        };
+
+        while (inputIndex < inputSize)
+        {
+            const unsigned char token = source[inputIndex++];
+            std::size_t literalLength = token >> 4;
+
+            if (literalLength == 15 && ReadLength(literalLength) == false)
+            {
+                return false;
+            }
+
+            if (literalLength > inputSize - inputIndex || literalLength > outputSize - outputIndex)
+            {
+                return false;
+            }
+
+            if (literalLength > 0)
+            {
+                std::memcpy(destination + outputIndex, source + inputIndex, literalLength);
+                inputIndex += literalLength;
+                outputIndex += literalLength;
+            }
+
+            // Note: The last sequence has no match.
+            if (inputIndex == inputSize)
+            {
+                break;
+            }
+
+            if (inputSize - inputIndex < 2)
+            {
+                return false;
+            }
+
+            const std::size_t offset = static_cast<std::size_t>(source[inputIndex]) | (static_cast<std::size_t>(source[inputIndex + 1]) << 8);
+            inputIndex += 2;
+
+            std::size_t matchLength = (token & 0x0F) + MinMatch;
+
+            if ((token & 0x0F) == 0x0F && ReadLength(matchLength) == false)
+            {
+                return false;
+            }
+
+            if (offset == 0 || offset > outputIndex || matchLength > outputSize - outputIndex)
+            {
+                return false;
+            }
+
+            const unsigned char* match = destination + outputIndex - offset;
+
+            if (offset >= matchLength)
+            {
+                std::memcpy(destination + outputIndex, match, matchLength);
+            }
+            else
+            {
+                // Note: Overlapping matches repeat the last "offset" bytes, so they are copied byte by byte.
+                for (std::size_t i = 0; i < matchLength; ++i)
+                {
+                    destination[outputIndex + i] = match[i];
+                }
+            }
+
+            outputIndex += matchLength;
+        }
+
+        return outputIndex == outputSize;
+    }
+
+    inline bool IsBlockFrame(const char* data, std::size_t size)
+    {
+        return size >= havSeriLiteBlockFrame::HeaderSize && std::memcmp(data, havSeriLiteBlockFrame::Magic, sizeof(havSeriLiteBlockFrame::Magic)) == 0;
+    }
+
+    // Note: Decompresses a frame held in memory into "output", on "numOfThreads" threads (all cores if zero). The blocks are located
+    // through the block index, or by walking the block headers if the frame has no valid footer (e.g. the sink was only flushed).
+    inline bool DecompressBlockFrame(const char* data, std::size_t size, std::vector<char>& output, std::size_t numOfThreads = 0)
+    {
+        using Frame = havSeriLiteBlockFrame;
+
+        if (IsBlockFrame(data, size) == false || static_cast<std::uint8_t>(data[sizeof(Frame::Magic)]) > Frame::Version)
+        {
+            return false;
+        }
+
+        struct havSeriLiteBlock
+        {
+            const char* mData;
+            std::uint32_t mStoredSize;
+            std::uint32_t mSize;
+            std::uint64_t mOffset;
+        };
+
+        std::vector<havSeriLiteBlock> blocks;
+        std::uint64_t uncompressedSize = 0;
+
+        auto AddBlock = [&](std::uint64_t position) {
+            if (position > size || size - position < Frame::BlockHeaderSize)
+            {
+                return false;
+            }
+
+            std::uint32_t blockHeader[2];
+            std::memcpy(blockHeader, data + position, sizeof(blockHeader));
+
+            const bool isStored = (blockHeader[0] & Frame::StoredFlag) != 0;
+            const std::uint64_t storedSize = blockHeader[0] & ~Frame::StoredFlag;
+
+            // Note: Rejects sizes the codec cannot produce, so corrupt headers cannot cause huge allocations.
+            if (blockHeader[1] == 0 || blockHeader[1] > Frame::MaxBlockSize || storedSize > size - position - Frame::BlockHeaderSize ||
+                (isStored == true ? storedSize != blockHeader[1] : blockHeader[1] > storedSize * 256))
+            {
+                return false;
+            }
+
+            blocks.push_back({ data + position + Frame::BlockHeaderSize, blockHeader[0], blockHeader[1], uncompressedSize });
+            uncompressedSize += blockHeader[1];
+
+            return true;
+        };
+
+        bool indexValid = false;
+
+        if (size >= Frame::HeaderSize + Frame::BlockHeaderSize + Frame::FooterSize && std::memcmp(data + size - sizeof(Frame::Magic), Frame::Magic, sizeof(Frame::Magic)) == 0)
+        {
+            std::uint64_t footer[3];
+            std::memcpy(footer, data + size - Frame::FooterSize, sizeof(footer));
+
+            const std::uint64_t indexEnd = size - Frame::FooterSize;
+            indexValid = footer[2] <= indexEnd && (indexEnd - footer[2]) / Frame::IndexEntrySize == footer[1] && (indexEnd - footer[2]) % Frame::IndexEntrySize == 0;
+
+            for (std::uint64_t i = 0; indexValid == true && i < footer[1]; ++i)
+            {
+                std::uint64_t entry[2];
+                std::memcpy(entry, data + footer[2] + i * Frame::IndexEntrySize, sizeof(entry));
+
+                indexValid = entry[1] == uncompressedSize && AddBlock(entry[0]);
+            }
+
+            indexValid = indexValid == true && uncompressedSize == footer[0];
+        }
+
+        if (indexValid == false)
+        {
+            blocks.clear();
+            uncompressedSize = 0;
+
+            std::size_t position = Frame::HeaderSize;
+
+            while (size - position >= Frame::BlockHeaderSize)
+            {
+                std::uint32_t blockHeader[2];
+                std::memcpy(blockHeader, data + position, sizeof(blockHeader));
+
+                if (blockHeader[0] == 0 && blockHeader[1] == 0)
+                {
+                    break;
+                }
+
+                if (AddBlock(position) == false)
+                {
+                    return false;
+                }
+
+                position += Frame::BlockHeaderSize + (blockHeader[0] & ~Frame::StoredFlag);
+            }
+        }
+
+        if (uncompressedSize > static_cast<std::uint64_t>(std::numeric_limits<std::size_t>::max()))
+        {
+            return false;
+        }
+
+        output.clear();
+        output.resize(static_cast<std::size_t>(uncompressedSize));
+
+        if (numOfThreads == 0)
+        {
+            numOfThreads = std::max<std::size_t>(std::thread::hardware_concurrency(), 1);
+        }
+
+        std::atomic<std::size_t> nextBlock { 0 };
+        std::atomic<bool> failed { false };
+
+        auto Worker = [&]() {
+            for (std::size_t i = nextBlock++; i < blocks.size() && failed == false; i = nextBlock++)
+            {
+                const havSeriLiteBlock& block = blocks[i];
+                char* destination = output.data() + block.mOffset;
+
+                if ((block.mStoredSize & Frame::StoredFlag) != 0)
+                {
+                    std::memcpy(destination, block.mData, block.mSize);
+                }
+                else if (DecompressBlock(block.mData, block.mStoredSize, destination, block.mSize) == false)
+                {
+                    failed = true;
+                }
+            }
+        };
+
+        std::vector<std::thread> threads;
+
+        for (std::size_t i = 1; i < std::min(numOfThreads, blocks.size()); ++i)
+        {
+            threads.emplace_back(Worker);
+        }
+
+        Worker();
+
+        for (std::thread& thread : threads)
+        {
+            thread.join();
+        }
+
+        return failed == false;
+    }
+
+    // Note: Compresses everything written to it in independently decodable blocks of "blockSize" bytes before handing it to "sink"
+    // (see "havSeriLiteBlockFrame"). The block index and footer are written by "Finish", which the destructor calls.
+    class havSeriLiteBlockSink : public havSeriLiteSink
+    {
+    public:
+        explicit havSeriLiteBlockSink(std::unique_ptr<havSeriLiteSink> sink, std::size_t blockSize = 64 * 1024) : mSink(std::move(sink)), mBlockSize(std::clamp<std::size_t>(blockSize, 1, havSeriLiteBlockFrame::MaxBlockSize)), mNumOfBytesWritten(0), mNumOfBytesConsumed(0), mFinished(false)
+        {
+            if (mSink == nullptr)
+            {
+                throw std::runtime_error("Unable to write to a null sink!");
+            }
+
+            mBlock.reserve(mBlockSize);
+        }
+
+        ~havSeriLiteBlockSink() override
+        {
+            Finish();
+        }
+
+        havSeriLiteBlockSink(const havSeriLiteBlockSink&) = delete;
+        havSeriLiteBlockSink& operator=(const havSeriLiteBlockSink&) = delete;
+
+        bool Write(const char* data, std::size_t size) override
+        {
+            if (mFinished == true)
+            {
+                return false;
+            }
+
+            while (size > 0)
+            {
+                // Note: Whole blocks are compressed straight from the caller's data instead of being copied first.
+                if (mBlock.empty() == true && size >= mBlockSize)
+                {
+                    if (WriteBlock(data, mBlockSize) == false)
+                    {
+                        return false;
+                    }
+
+                    data += mBlockSize;
+                    size -= mBlockSize;
+                    continue;
+                }
+
+                const std::size_t numOfBytes = std::min(size, mBlockSize - mBlock.size());
+                mBlock.insert(mBlock.end(), data, data + numOfBytes);
+                data += numOfBytes;
+                size -= numOfBytes;
+
+                if (mBlock.size() == mBlockSize && FlushBlock() == false)
+                {
+                    return false;
+                }
+            }
+
+            return true;
+        }
+
+        // Note: Writes the pending bytes as a shorter block, so everything written so far reaches the underlying sink.
+        bool Flush() override
+        {
+            if (mFinished == false && FlushBlock() == false)
+            {
+                return false;
+            }
+
+            return mSink->Flush();
+        }
+
+        // Note: Writes the pending bytes, the end block, the block index and the footer. Writes after this fail.
+        bool Finish()
+        {
+            if (mFinished == true)
+            {
+                return true;
+            }
+
+            mFinished = true;
+
+            if (FlushBlock() == false || (mNumOfBytesWritten == 0 && WriteFrameHeader() == false))
+            {
+                return false;
+            }
+
+            const char endBlock[havSeriLiteBlockFrame::BlockHeaderSize] = {};
+            const std::uint64_t footer[3] = { mNumOfBytesConsumed, mIndex.size() / 2, mNumOfBytesWritten + sizeof(endBlock) };
+
+            const havSeriLiteBufferView buffers[4] = {
+                { endBlock, sizeof(endBlock) },
+                { reinterpret_cast<const char*>(mIndex.data()), mIndex.size() * sizeof(std::uint64_t) },
+                { reinterpret_cast<const char*>(footer), sizeof(footer) },
+                { havSeriLiteBlockFrame::Magic, sizeof(havSeriLiteBlockFrame::Magic) }
+            };
+
+            return mSink->WriteVector(buffers, 4) == true && mSink->Flush() == true;
+        }
+
+    private:
+        bool WriteFrameHeader()
+        {
+            char header[havSeriLiteBlockFrame::HeaderSize] = {};
+            const std::uint32_t blockSize = static_cast<std::uint32_t>(mBlockSize);
+
+            std::memcpy(header, havSeriLiteBlockFrame::Magic, sizeof(havSeriLiteBlockFrame::Magic));
+            header[sizeof(havSeriLiteBlockFrame::Magic)] = static_cast<char>(havSeriLiteBlockFrame::Version);
+            std::memcpy(header + havSeriLiteBlockFrame::HeaderSize - sizeof(blockSize), &blockSize, sizeof(blockSize));
+
+            if (mSink->Write(header, sizeof(header)) == false)
+            {
+                return false;
+            }
+
+            mNumOfBytesWritten += sizeof(header);
+
+            return true;
+        }
+
+        bool FlushBlock()
+        {
+            if (mBlock.empty() == true)
+            {
+                return true;
+            }
+
+            const bool result = WriteBlock(mBlock.data(), mBlock.size());
+            mBlock.clear();
+
+            return result;
+        }
+
+        bool WriteBlock(const char* data, std::size_t size)
+        {
+            if (mNumOfBytesWritten == 0 && WriteFrameHeader() == false)
+            {
+                return false;
+            }
+
+            mCompressed.resize(GetMaxCompressedSize(size));
+
+            std::size_t storedSize = CompressBlock(data, size, mCompressed.data());
+            std::uint32_t blockHeader[2] = { static_cast<std::uint32_t>(storedSize), static_cast<std::uint32_t>(size) };
+            const char* payload = mCompressed.data();
+
+            // Note: Incompressible blocks are stored as they are, so the output never grows by more than the framing.
+            if (storedSize >= size)
+            {
+                storedSize = size;
+                blockHeader[0] = static_cast<std::uint32_t>(size) | havSeriLiteBlockFrame::StoredFlag;
+                payload = data;
+            }
+
+            const havSeriLiteBufferView buffers[2] = {
+                { reinterpret_cast<const char*>(blockHeader), sizeof(blockHeader) },
+                { payload, storedSize }
+            };
+
+            if (mSink->WriteVector(buffers, 2) == false)
+            {
+                return false;
+            }
+
+            mIndex.push_back(mNumOfBytesWritten);
+            mIndex.push_back(mNumOfBytesConsumed);
+            mNumOfBytesWritten += sizeof(blockHeader) + storedSize;
+            mNumOfBytesConsumed += size;
+
+            return true;
+        }
+
+        std::unique_ptr<havSeriLiteSink> mSink;
+        std::size_t mBlockSize;
+        std::vector<char> mBlock;
+        std::vector<char> mCompressed;
+        // Note: One "havSeriLiteBlockFrame::IndexEntrySize" entry per block, ready to be written as the block index.
+        std::vector<std::uint64_t> mIndex;
+        std::uint64_t mNumOfBytesWritten;
+        std::uint64_t mNumOfBytesConsumed;
+        bool mFinished;
+    };
+
+    // Note: Decompresses the output of "havSeriLiteBlockSink" one block at a time while reading it from "source", for use with
+    // "havSeriLiteReader::ReadStream". Blocks that are skipped entirely are passed over with "Skip" without being decompressed.
+    class havSeriLiteBlockSource : public havSeriLiteSource
+    {
+    public:
+        explicit havSeriLiteBlockSource(std::unique_ptr<havSeriLiteSource> source) : mSource(std::move(source)), mBlockPosition(0), mHeaderRead(false), mEndOfFrame(false)
+        {
+            if (mSource == nullptr)
+            {
+                throw std::runtime_error("Unable to read from a null source!");
+            }
+        }
+
+        havSeriLiteBlockSource(const havSeriLiteBlockSource&) = delete;
+        havSeriLiteBlockSource& operator=(const havSeriLiteBlockSource&) = delete;
+
+        std::size_t Read(char* data, std::size_t size) override
+        {
+            std::size_t totalSize = 0;
+
+            while (totalSize < size)
+            {
+                if (mBlockPosition == mBlock.size())
+                {
+                    std::uint32_t blockHeader[2];
+
+                    if (ReadBlockHeader(blockHeader) == false || ReadBlock(blockHeader) == false)
+                    {
+                        break;
+                    }
+                }
+
+                const std::size_t numOfBytes = std::min(size - totalSize, mBlock.size() - mBlockPosition);
+                std::memcpy(data + totalSize, mBlock.data() + mBlockPosition, numOfBytes);
+                mBlockPosition += numOfBytes;
+                totalSize += numOfBytes;
+            }
+
+            return totalSize;
+        }
+
+        bool Skip(std::uint64_t size) override
+        {
+            while (size > 0)
+            {
+                if (mBlockPosition == mBlock.size())
+                {
+                    std::uint32_t blockHeader[2];
+
+                    if (ReadBlockHeader(blockHeader) == false)
+                    {
+                        return false;
+                    }
+
+                    if (blockHeader[1] <= size)
+                    {
+                        if (mSource->Skip(blockHeader[0] & ~havSeriLiteBlockFrame::StoredFlag) == false)
+                        {
+                            return false;
+                        }
+
+                        size -= blockHeader[1];
+                        continue;
+                    }
+
+                    if (ReadBlock(blockHeader) == false)
+                    {
+                        return false;
+                    }
+                }
+
+                const std::size_t numOfBytes = static_cast<std::size_t>(std::min<std::uint64_t>(size, mBlock.size() - mBlockPosition));
+                mBlockPosition += numOfBytes;
+                size -= numOfBytes;
+            }
+
+            return true;
+        }
+
+    private:
+        bool ReadExactly(char* data, std::size_t size)
+        {
+            while (size > 0)
+            {
+                const std::size_t numOfBytes = mSource->Read(data, size);
+
+                if (numOfBytes == 0)
+                {
+                    return false;
+                }
+
+                data += numOfBytes;
+                size -= numOfBytes;
+            }
+
+            return true;
+        }
+
+        bool ReadBlockHeader(std::uint32_t (&blockHeader)[2])
+        {
+            if (mEndOfFrame == true)
+            {
+                return false;
+            }
+
+            if (mHeaderRead == false)
+            {
+                char header[havSeriLiteBlockFrame::HeaderSize];
+
+                if (ReadExactly(header, sizeof(header)) == false || IsBlockFrame(header, sizeof(header)) == false || static_cast<std::uint8_t>(header[sizeof(havSeriLiteBlockFrame::Magic)]) > havSeriLiteBlockFrame::Version)
+                {
+                    std::cerr << "Error: Invalid compressed frame header!" << std::endl;
+                    mEndOfFrame = true;
+                    return false;
+                }
+
+                mHeaderRead = true;
+            }
+
+            // Note: Frames that were flushed but not finished end without an end block.
+            if (ReadExactly(reinterpret_cast<char*>(blockHeader), sizeof(blockHeader)) == false || (blockHeader[0] == 0 && blockHeader[1] == 0))
+            {
+                mEndOfFrame = true;
+                return false;
+            }
+
+            const std::uint32_t storedSize = blockHeader[0] & ~havSeriLiteBlockFrame::StoredFlag;
+
+            if (blockHeader[1] == 0 || blockHeader[1] > havSeriLiteBlockFrame::MaxBlockSize ||
+                ((blockHeader[0] & havSeriLiteBlockFrame::StoredFlag) != 0 ? storedSize != blockHeader[1] : storedSize > GetMaxCompressedSize(blockHeader[1])))
+            {
+                std::cerr << "Error: Corrupt compressed block!" << std::endl;
+                mEndOfFrame = true;
+                return false;
+            }
+
+            return true;
+        }
+
+        bool ReadBlock(const std::uint32_t (&blockHeader)[2])
+        {
+            const std::uint32_t storedSize = blockHeader[0] & ~havSeriLiteBlockFrame::StoredFlag;
+
+            mBlock.resize(blockHeader[1]);
+            mBlockPosition = 0;
+
+            if ((blockHeader[0] & havSeriLiteBlockFrame::StoredFlag) != 0)
+            {
+                if (ReadExactly(mBlock.data(), mBlock.size()) == true)
+                {
+                    return true;
+                }
+            }
+            else
+            {
+                mCompressed.resize(storedSize);
+
+                if (ReadExactly(mCompressed.data(), mCompressed.size()) == true && DecompressBlock(mCompressed.data(), mCompressed.size(), mBlock.data(), mBlock.size()) == true)
+                {
+                    return true;
+                }
+            }
+
+            std::cerr << "Error: Corrupt compressed block!" << std::endl;
+            mBlock.clear();
+            mEndOfFrame = true;
+
+            return false;
+        }
+
+        std::unique_ptr<havSeriLiteSource> mSource;
+        std::vector<char> mBlock;
+        std::vector<char> mCompressed;
+        std::size_t mBlockPosition;
+        bool mHeaderRead;
+        bool mEndOfFrame;
+    };
+
+    // Note: Layout of append-only logs (see "havSeriLiteLogWriter"). The header is followed by records of a payload size, a CRC-32C of
+    // the size and the payload, and the payload, which is a complete havSeriLite stream of its own.
+    struct havSeriLiteLogFrame
+    {
+        static constexpr char Magic[4] = { 'H', 'S', 'L', 'J' };
+        static constexpr std::uint8_t Version = 1;
+        // Note: Magic, version and three reserved bytes.
+        static constexpr std::size_t HeaderSize = sizeof(Magic) + 4;
+        // Note: Payload size and checksum.
+        static constexpr std::size_t RecordHeaderSize = 2 * sizeof(std::uint32_t);
+        static constexpr std::size_t MaxRecordSize = 256 * 1024 * 1024;
+    };
+
+    struct havSeriLiteCrc32cTable
+    {
+        std::uint32_t mValues[8][256];
+    };
+
+    // Note: Tables for slicing-by-8, the first one is the classic byte-at-a-time table of the reflected polynomial 0x82F63B78.
+    constexpr havSeriLiteCrc32cTable CreateCrc32cTable()
+    {
+        havSeriLiteCrc32cTable table {};
+
+        for (std::uint32_t i = 0; i < 256; ++i)
+        {
+            std::uint32_t crc = i;
+
+            for (int bit = 0; bit < 8; ++bit)
+            {
+                crc = (crc >> 1) ^ ((crc & 1) != 0 ? 0x82F63B78u : 0);
+            }
+
+            table.mValues[0][i] = crc;
+        }
+
+        for (std::size_t slice = 1; slice < 8; ++slice)
+        {
+            for (std::size_t i = 0; i < 256; ++i)
+            {
+                const std::uint32_t previous = table.mValues[slice - 1][i];
+                table.mValues[slice][i] = (previous >> 8) ^ table.mValues[0][previous & 0xFF];
+            }
+        }
+
+        return table;
+    }
+
+    inline constexpr havSeriLiteCrc32cTable Crc32cTable = CreateCrc32cTable();
+
+    // Note: Continues the checksum "crc" of preceding data, which is zero for the first call.
+    inline std::uint32_t ComputeCrc32c(const char* data, std::size_t size, std::uint32_t crc = 0)
+    {
+        const auto* bytes = reinterpret_cast<const std::uint8_t*>(data);
+        const auto& table = Crc32cTable.mValues;
+
+        crc = ~crc;
+
+        for (; size >= 8; bytes += 8, size -= 8)
+        {
+            crc ^= static_cast<std::uint32_t>(bytes[0]) | static_cast<std::uint32_t>(bytes[1]) << 8 | static_cast<std::uint32_t>(bytes[2]) << 16 | static_cast<std::uint32_t>(bytes[3]) << 24;
+            crc = table[7][crc & 0xFF] ^ table[6][(crc >> 8) & 0xFF] ^ table[5][(crc >> 16) & 0xFF] ^ table[4][crc >> 24] ^
+                  table[3][bytes[4]] ^ table[2][bytes[5]] ^ table[1][bytes[6]] ^ table[0][bytes[7]];
+        }
+
+        for (; size > 0; ++bytes, --size)
+        {
+            crc = (crc >> 8) ^ table[0][(crc ^ *bytes) & 0xFF];
+        }
+
+        return ~crc;
+    }
+
+    // Note: Returns the length of the leading whole eight-byte chunks of "data" without quotes, backslashes or control characters,
+    // which pass through JSON strings unchanged. The bytes behind them have to be checked one at a time.
+    inline std::size_t ScanJsonPlainChunks(const char* data, std::size_t size)
+    {
+        constexpr std::uint64_t Ones = 0x0101010101010101ull;
+        constexpr std::uint64_t Highs = 0x8080808080808080ull;
+
+        auto HasZeroByte = [](std::uint64_t chunk) {
+            return (chunk - Ones) & ~chunk & Highs;
+        };
+
+        std::size_t i = 0;
+
+        for (; size - i >= sizeof(std::uint64_t); i += sizeof(std::uint64_t))
+        {
+            std::uint64_t chunk;
+            std::memcpy(&chunk, data + i, sizeof(chunk));
+
+            if ((((chunk - Ones * 0x20) & ~chunk & Highs) | HasZeroByte(chunk ^ (Ones * '"')) | HasZeroByte(chunk ^ (Ones * '\\'))) != 0)
+            {
+                break;
+            }
+        }
+
+        return i;
+    }
+
+    struct havSeriLiteJsonOptions
+    {
+        // Note: Puts every element on its own line, indented by "mIndentSize" spaces per level. Compact output has no whitespace.
+        bool mPretty = false;
+        std::uint32_t mIndentSize = 4;
+        std::size_t mBufferCapacity = 64 * 1024;
+    };
+
+    // Note: Writes JSON text to a sink through a buffer, which is only handed over when full or on "Flush". Like with "havSeriLiteWriter",
+    // every other value of an object, starting with the first, is a key. Keys that are not strings are quoted.
+    class havSeriLiteJsonWriter
+    {
+    public:
+        // Note: "depthLevel" is the indentation level of the first value, for output that continues enclosing text.
+        explicit havSeriLiteJsonWriter(havSeriLiteSink& sink, const havSeriLiteJsonOptions& options = havSeriLiteJsonOptions {}, std::int32_t depthLevel = 0) : mSink(sink), mOptions(options), mSize(0), mBaseDepthLevel(depthLevel), mNumOfValues(0), mWriteFailed(false)
+        {
+            mBuffer.resize(std::max<std::size_t>(mOptions.mBufferCapacity, 64));
+        }
+
+        ~havSeriLiteJsonWriter()
+        {
+            FlushBuffer();
+        }
+
+        havSeriLiteJsonWriter(const havSeriLiteJsonWriter&) = delete;
+        havSeriLiteJsonWriter& operator=(const havSeriLiteJsonWriter&) = delete;
+
+        void WriteNull() { WriteLiteral(BeginValue(), "null"); }
+        void WriteBool(bool value) { WriteLiteral(BeginValue(), value == true ? "true" : "false"); }
+        void WriteInt64(std::int64_t value) { WriteNumber(BeginValue(), value); }
+        void WriteUInt64(std::uint64_t value) { WriteNumber(BeginValue(), value); }
+
+        // Note: Writes the shortest text that reads back as the same double. Integral values keep a ".0", so they stay doubles when
+        // read back, and NaN and infinities, which JSON cannot represent, are written as "null".
+        void WriteDouble(double value)
+        {
+            const bool isKey = BeginValue();
+
+            if (value != value || value - value != 0.0)
+            {
+                WriteLiteral(isKey, "null");
+                return;
+            }
+
+            char* data = Reserve(32);
+            const std::size_t start = isKey == true ? 1 : 0;
+            const std::size_t length = static_cast<std::size_t>(std::to_chars(data + start, data + 30, value).ptr - (data + start));
+
+            std::size_t size = start + length;
+
+            if (std::string_view { data + start, length }.find_first_of(".e") == std::string_view::npos)
+            {
+                data[size++] = '.';
+                data[size++] = '0';
+            }
+
+            if (isKey == true)
+            {
+                data[0] = '"';
+                data[size++] = '"';
+            }
+
+            mSize += size;
+        }
+
+        void WriteString(std::string_view value)
+        {
+            BeginValue();
+            AppendEscaped(value);
+        }
+
+        // Note: Writes binary data as a base64 string, as JSON has no binary type.
+        void WriteBase64(std::string_view value)
+        {
+            constexpr char Digits[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+            const auto* bytes = reinterpret_cast<const std::uint8_t*>(value.data());
+            std::size_t size = value.size();
+
+            BeginValue();
+            Append('"');
+
+            // Note: Encodes 48 bytes into 64 characters at a time, which always fit the buffer. Only the last run is padded.
+            while (size > 0)
+            {
+                const std::size_t numOfBytes = std::min<std::size_t>(size, 48);
+                char* data = Reserve(64);
+                std::size_t length = 0;
+
+                for (std::size_t i = 0; i < numOfBytes; i += 3)
+                {
+                    const std::size_t remaining = numOfBytes - i;
+                    const std::uint32_t bits = static_cast<std::uint32_t>(bytes[i]) << 16 | (remaining > 1 ? static_cast<std::uint32_t>(bytes[i + 1]) << 8 : 0) | (remaining > 2 ? bytes[i + 2] : 0);
+
+                    data[length++] = Digits[bits >> 18];
+                    data[length++] = Digits[(bits >> 12) & 0x3F];
+                    data[length++] = remaining > 1 ? Digits[(bits >> 6) & 0x3F] : '=';
+                    data[length++] = remaining > 2 ? Digits[bits & 0x3F] : '=';
+                }
+
+                mSize += length;
+                bytes += numOfBytes;
+                size -= numOfBytes;
+            }
+
+            Append('"');
+        }
+
+        void WriteArray() { BeginContainer(false); }
+        void WriteObject() { BeginContainer(true); }
+
+        // Note: Closes the innermost array or object. An object ending with a key gets "null" as its value.
+        void WriteClose()
+        {
+            if (mContainers.empty() == true)
+            {
+                return;
+            }
+
+            if (mContainers.back().mIsObject == true && mContainers.back().mCount % 2 != 0)
+            {
+                WriteNull();
+            }
+
+            const havSeriLiteJsonContainer container = mContainers.back();
+            mContainers.pop_back();
+
+            if (container.mCount > 0)
+            {
+                AppendNewLine();
+            }
+
+            Append(container.mIsObject == true ? '}' : ']');
+        }
+
+        // Note: Hands the buffered text to the sink and flushes the sink. Returns "false" if any write since the last flush failed.
+        bool Flush()
+        {
+            bool result = FlushBuffer();
+            result &= mSink.Flush();
+            result &= !mWriteFailed;
+            mWriteFailed = false;
+
+            return result;
+        }
+
+    private:
+        struct havSeriLiteJsonContainer
+        {
+            bool mIsObject;
+            std::uint64_t mCount;
+        };
+
+        // Note: Writes the separator in front of a value and returns whether the value is an object key.
+        bool BeginValue()
+        {
+            if (mContainers.empty() == true)
+            {
+                // Note: Consecutive top-level values are separated by line breaks, as in JSON Lines.
+                if (mNumOfValues++ > 0)
+                {
+                    Append('\n');
+                }
+
+                return false;
+            }
+
+            havSeriLiteJsonContainer& container = mContainers.back();
+            const bool isValue = container.mIsObject == true && container.mCount % 2 != 0;
+
+            if (isValue == true)
+            {
+                Append(':');
+
+                if (mOptions.mPretty == true)
+                {
+                    Append(' ');
+                }
+            }
+            else
+            {
+                if (container.mCount > 0)
+                {
+                    Append(',');
+                }
+
+                AppendNewLine();
+            }
+
+            ++container.mCount;
+
+            return container.mIsObject == true && isValue == false;
+        }
+
+        void BeginContainer(bool isObject)
+        {
+            // Note: JSON has no container keys, so these are written as empty strings instead.
+            if (BeginValue() == true)
+            {
+                AppendRaw("\"\"", 2);
+            }
+
+            Append(isObject == true ? '{' : '[');
+            mContainers.push_back(havSeriLiteJsonContainer { isObject, 0 });
+        }
+
+        void WriteLiteral(bool isKey, std::string_view literal)
+        {
+            if (isKey == true)
+            {
+                Append('"');
+            }
+
+            AppendRaw(literal.data(), literal.size());
+
+            if (isKey == true)
+            {
+                Append('"');
+            }
+        }
+
+        template<typename T>
+        void WriteNumber(bool isKey, T value)
+        {
+            char* data = Reserve(24);
+            const std::size_t start = isKey == true ? 1 : 0;
+            std::size_t size = static_cast<std::size_t>(std::to_chars(data + start, data + 22, value).ptr - data);
+
+            if (isKey == true)
+            {
+                data[0] = '"';
+                data[size++] = '"';
+            }
+
+            mSize += size;
+        }
+
+        void AppendNewLine()
+        {
+            if (mOptions.mPretty == false)
+            {
+                return;
+            }
+
+            const std::size_t numOfSpaces = static_cast<std::size_t>(std::max<std::int64_t>(mBaseDepthLevel + static_cast<std::int64_t>(mContainers.size()), 0)) * mOptions.mIndentSize;
+
+            Append('\n');
+
+            for (std::size_t remaining = numOfSpaces; remaining > 0;)
+            {
+                const std::size_t numOfBytes = std::min(remaining, mBuffer.size());
+                std::memset(Reserve(numOfBytes), ' ', numOfBytes);
+                mSize += numOfBytes;
+                remaining -= numOfBytes;
+            }
+        }
+
+        // Note: Scans eight bytes at a time for quotes, backslashes and control characters, and copies the runs between them in bulk.
+        void AppendEscaped(std::string_view value)
+        {
+            const char* data = value.data();
+            const std::size_t size = value.size();
+            std::size_t runStart = 0;
+            std::size_t i = 0;
+
+            Append('"');
+
+            while (i < size)
+            {
+                i += ScanJsonPlainChunks(data + i, size - i);
+
+                for (const std::size_t end = std::min(size, i + sizeof(std::uint64_t)); i < end; ++i)
+                {
+                    const unsigned char character = static_cast<unsigned char>(data[i]);
+
+                    if (character >= 0x20 && character != '"' && character != '\\')
+                    {
+                        continue;
+                    }
+
+                    AppendRaw(data + runStart, i - runStart);
+                    runStart = i + 1;
+
+                    switch (character)
+                    {
+                        case '"':  AppendRaw("\\\"", 2); break;
+                        case '\\': AppendRaw("\\\\", 2); break;
+                        case '\b': AppendRaw("\\b", 2); break;
+                        case '\f': AppendRaw("\\f", 2); break;
+                        case '\n': AppendRaw("\\n", 2); break;
+                        case '\r': AppendRaw("\\r", 2); break;
+                        case '\t': AppendRaw("\\t", 2); break;
+                        default:
+                            {
+                                constexpr char HexDigits[] = "0123456789abcdef";
+                                const char escape[6] = { '\\', 'u', '0', '0', HexDigits[character >> 4], HexDigits[character & 0x0F] };
+                                AppendRaw(escape, sizeof(escape));
+                            }
+                            break;
+                    }
+                }
+            }
+
+            AppendRaw(data + runStart, size - runStart);
+            Append('"');
+        }
+
+        inline void Append(char character)
+        {
+            *Reserve(1) = character;
+            ++mSize;
+        }
+
+        void AppendRaw(const char* data, std::size_t size)
+        {
+            if (size <= mBuffer.size() - mSize)
+            {
+                std::memcpy(mBuffer.data() + mSize, data, size);
+                mSize += size;
+                return;
+            }
+
+            FlushBuffer();
+
+            // Note: Runs larger than the buffer go to the sink directly instead of being copied in pieces.
+            if (size >= mBuffer.size())
+            {
+                mWriteFailed |= !mSink.Write(data, size);
+                return;
+            }
+
+            std::memcpy(mBuffer.data(), data, size);
+            mSize = size;
+        }
+
+        // Note: Makes room for "size" bytes at "mBuffer.data() + mSize", which must be at most the buffer capacity.
+        inline char* Reserve(std::size_t size)
+        {
+            if (size > mBuffer.size() - mSize)
+            {
+                FlushBuffer();
+            }
+
+            return mBuffer.data() + mSize;
+        }
+
+        bool FlushBuffer()
+        {
+            if (mSize == 0)
+            {
+                return true;
+            }
+
+            const bool result = mSink.Write(mBuffer.data(), mSize);
+            mWriteFailed |= !result;
+            mSize = 0;
+
+            return result;
+        }
+
+        havSeriLiteSink& mSink;
+        havSeriLiteJsonOptions mOptions;
+        std::vector<char> mBuffer;
+        std::size_t mSize;
+        std::vector<havSeriLiteJsonContainer> mContainers;
+        std::int32_t mBaseDepthLevel;
+        std::uint64_t mNumOfValues;
+        bool mWriteFailed;
+    };
+
+    class havSeriLiteLogWriter;
+
+    template<typename T, typename = void>
+    struct havSeriLiteSerializer;
+
+    // Note: Deleter of the sink of a writer, which deletes sinks handed over with "SetSink" but not ones borrowed with "Reset".
+    struct havSeriLiteSinkDeleter
+    {
+        havSeriLiteSinkDeleter() = default;
+        explicit havSeriLiteSinkDeleter(bool owned) : mOwned(owned) {}
+
+        template<typename T, typename = std::enable_if_t<std::is_convertible_v<T*, havSeriLiteSink*>>>
+        havSeriLiteSinkDeleter(const std::default_delete<T>&) {}
+
+        inline void operator()(havSeriLiteSink* sink) const
+        {
+            if (mOwned == true)
+            {
+                delete sink;
+            }
+        }
+
+        bool mOwned = true;
+    };
+
+    class havSeriLiteWriter
+    {
+    public:
+        // Note: Creates a writer without output, which starts writing on the first "Reset" or "SetSink".
+        explicit havSeriLiteWriter(const havSeriLiteWriterOptions& options = havSeriLiteWriterOptions {}) : mOptions(options), mNumOfSizedContainers(0), mNumOfBytesFlushed(0), mWriteFailed(false)
+        {
+            mBuffer = havSeriLiteBufferPool::Acquire(mOptions.mBufferCapacity);
+        }
+
+        explicit havSeriLiteWriter(const std::string& fileName, const havSeriLiteWriterOptions& options = havSeriLiteWriterOptions {}) : mOptions(options), mNumOfSizedContainers(0), mNumOfBytesFlushed(0), mWriteFailed(false)
+        {
+            if (WriteFile(fileName) == false)
+            {
+                throw std::runtime_error("Unable to write file: " + fileName);
+            }
+        }
+
+        explicit havSeriLiteWriter(std::unique_ptr<havSeriLiteSink> sink, const havSeriLiteWriterOptions& options = havSeriLiteWriterOptions {}) : mSink(std::move(sink)), mOptions(options), mNumOfSizedContainers(0), mNumOfBytesFlushed(0), mWriteFailed(false)
+        {
+            if (mSink == nullptr)
+            {
+                throw std::runtime_error("Unable to write to a null sink!");
+            }
+
+            mBuffer = havSeriLiteBufferPool::Acquire(mOptions.mBufferCapacity);
+            WriteHeader();
+        }
+
+        ~havSeriLiteWriter()
+        {
+            FlushBuffer(true);
+
+            if (mSink != nullptr)
+            {
+                mSink->Flush();
+            }
+
+            havSeriLiteBufferPool::Release(std::move(mBuffer));
+        }
+
+        havSeriLiteWriter(havSeriLiteWriter&&) = default;
+        havSeriLiteWriter& operator=(havSeriLiteWriter&&) = delete;
+
+        void WriteValue(const havSeriLiteValue& value)
+        {
+            switch (value.mType)
+            {
+                case havSeriLiteValueType::Boolean: WriteBool(std::get<bool>(value.mData)); break;
+                case havSeriLiteValueType::Int32:   WriteInt32(std::get<std::int32_t>(value.mData)); break;
+                case havSeriLiteValueType::UInt32:  WriteUInt32(std::get<std::uint32_t>(value.mData)); break;
+                case havSeriLiteValueType::Int64:   WriteInt64(std::get<std::int64_t>(value.mData)); break;
+                case havSeriLiteValueType::UInt64:  WriteUInt64(std::get<std::uint64_t>(value.mData)); break;
+                case havSeriLiteValueType::Double:  WriteDouble(std::get<double>(value.mData)); break;
+                case havSeriLiteValueType::String:  WriteString(std::get<havSeriLiteValue::havSeriLiteStringData>(value.mData).mValue); break;
+                case havSeriLiteValueType::Bytes:
+                    {
+                        const std::string& bytes = std::get<havSeriLiteValue::havSeriLiteStringData>(value.mData).mValue;
+                        WriteBytes(bytes.data(), bytes.size());
+                    }
+                    break;
+                case havSeriLiteValueType::Array:   WriteArray(); break;
+                case havSeriLiteValueType::Object:  WriteObject(); break;
+                case havSeriLiteValueType::Close:   WriteClose(); break;
+                // Note: Typed arrays and records carry no elements in "havSeriLiteValue", use "WriteTypedArray" and "BeginRecord" instead.
+                case havSeriLiteValueType::TypedArray:
+                case havSeriLiteValueType::Record:  break;
+                default:                            WriteNull(); break;
+            }
+        }
+
+        // Note: The typed calls encode straight into the output buffer, without a "havSeriLiteValue" or any other temporary.
+        inline void WriteNull()
+        {
+            CountValue(havSeriLiteValueType::Null);
+            AppendTag(havSeriLiteValueType::Null);
+        }
+
+        inline void WriteBool(bool value)
+        {
+            CountValue(havSeriLiteValueType::Boolean);
+            AppendBoolean(value);
+        }
+
+        inline void WriteInt32(std::int32_t value) { CountValue(havSeriLiteValueType::Int32); AppendInteger(havSeriLiteValueType::Int32, value); }
+        inline void WriteUInt32(std::uint32_t value) { CountValue(havSeriLiteValueType::UInt32); AppendInteger(havSeriLiteValueType::UInt32, value); }
+        inline void WriteInt64(std::int64_t value) { CountValue(havSeriLiteValueType::Int64); AppendInteger(havSeriLiteValueType::Int64, value); }
+        inline void WriteUInt64(std::uint64_t value) { CountValue(havSeriLiteValueType::UInt64); AppendInteger(havSeriLiteValueType::UInt64, value); }
+
+        inline void WriteDouble(double value)
+        {
+            CountValue(havSeriLiteValueType::Double);
+            AppendTag(havSeriLiteValueType::Double);
+            Append(&value, sizeof(double));
+        }
+
+        inline void WriteString(std::string_view value)
+        {
+            // Note: Every other value of an object, starting with the first, is a key.
+            const bool isKey = mContainers.empty() == false && mContainers.back().mType == havSeriLiteValueType::Object && mContainers.back().mCount % 2 == 0;
+
+            CountValue(havSeriLiteValueType::String);
+            AppendString(value, isKey == true ? mOptions.mInternKeys : mOptions.mInternValues);
+        }
+
+        inline void WriteString(const char* data, std::size_t size) { WriteString(std::string_view { data, size }); }
+
+        // Note: Writes binary data as a "Bytes" value, which is never interned.
+        inline void WriteBytes(const void* data, std::size_t size)
+        {
+            CountValue(havSeriLiteValueType::Bytes);
+            AppendTag(havSeriLiteValueType::Bytes);
+            AppendLength(size);
+            AppendPayload(static_cast<const char*>(data), size);
+        }
+
+#if HAVSERILITE_HAS_SPAN
+        inline void WriteBytes(std::span<const std::byte> data) { WriteBytes(data.data(), data.size()); }
+#endif
+
+        inline void WriteArray()
+        {
+            CountValue(havSeriLiteValueType::Array);
+            BeginContainer(havSeriLiteValueType::Array, mOptions.mSizedContainers);
+        }
+
+        inline void WriteObject()
+        {
+            CountValue(havSeriLiteValueType::Object);
+            BeginContainer(havSeriLiteValueType::Object, mOptions.mSizedContainers);
+        }
+
+        // Note: Marks the end of the current object or array in the serialized structure.
+        inline void WriteClose()
+        {
+            HAVSERILITE_STATS(CountValueType(havSeriLiteValueType::Close));
+            AppendTag(havSeriLiteValueType::Close);
+            EndContainer();
+        }
+
+        inline void WriteCloseArray() { WriteClose(); }
+        inline void WriteCloseObject() { WriteClose(); }
+
+        // Note: Writes "value" with the matching typed call: booleans, integers as the narrowest of "Int32", "UInt32", "Int64" and
+        // "UInt64" of the same signedness, floating point numbers as "Double" and anything convertible to "std::string_view" as a string.
+        // Other types are written with "havSeriLiteSerializer" (e.g. types described with "HAVSERILITE_FIELDS", vectors and optionals).
+        template<typename T>
+        void Write(const T& value)
+        {
+            if constexpr (std::is_same_v<T, bool>)
+            {
+                WriteBool(value);
+            }
+            else if constexpr (std::is_integral_v<T> && std::is_signed_v<T>)
+            {
+                if constexpr (sizeof(T) <= sizeof(std::int32_t))
+                {
+                    WriteInt32(value);
+                }
+                else
+                {
+                    WriteInt64(value);
+                }
+            }
+            else if constexpr (std::is_integral_v<T>)
+            {
+                if constexpr (sizeof(T) <= sizeof(std::uint32_t))
+                {
+                    WriteUInt32(value);
+                }
+                else
+                {
+                    WriteUInt64(value);
+                }
+            }
+            else if constexpr (std::is_floating_point_v<T>)
+            {
+                WriteDouble(static_cast<double>(value));
+            }
+            else if constexpr (std::is_same_v<T, std::nullptr_t>)
+            {
+                WriteNull();
+            }
+            else if constexpr (std::is_convertible_v<const T&, std::string_view>)
+            {
+                WriteString(std::string_view { value });
+            }
+            else if constexpr (std::is_same_v<T, havSeriLiteValue>)
+            {
+                WriteValue(value);
+            }
+            else
+            {
+                havSeriLiteSerializer<T>::Write(*this, value);
+            }
+        }
+
+        // Note: Writes an object member, "key" followed by "value" (see "Write").
+        template<typename T>
+        inline void WriteKeyValue(std::string_view key, const T& value)
+        {
+            WriteString(key);
+            Write(value);
+        }
+
+        inline void WriteKeyValue(std::string_view key, const char* value) { WriteString(key); WriteString(std::string_view { value }); }
+        inline void WriteKeyBytes(std::string_view key, const void* data, std::size_t size) { WriteString(key); WriteBytes(data, size); }
+
+        // Note: Writes the elements as one packed, aligned payload in native byte order instead of one tagged value per element.
+        template<typename T>
+        void WriteTypedArray(const T* data, std::size_t count)
+        {
+            constexpr havSeriLiteValueType elementType = havSeriLiteTypedArrayTraits<T>::ElementType;
+
+            CountValue(havSeriLiteValueType::TypedArray);
+
+            AppendTag(havSeriLiteValueType::TypedArray);
+            AppendTag(elementType);
+            AppendCount(count);
+
+            // Note: Pads the payload to the element alignment within the stream, so readers can copy or map it in bulk.
+            const std::uint8_t padding = static_cast<std::uint8_t>((sizeof(T) - (GetPosition() + 1) % sizeof(T)) % sizeof(T));
+            const char paddingBytes[sizeof(T) + 1] = { static_cast<char>(padding) };
+            Append(paddingBytes, padding + 1);
+
+            AppendPayload(reinterpret_cast<const char*>(data), count * sizeof(T));
+        }
+
+        template<typename T>
+        inline void WriteTypedArray(const std::vector<T>& values) { WriteTypedArray(values.data(), values.size()); }
+
+#if HAVSERILITE_HAS_SPAN
+        template<typename T>
+        inline void WriteTypedArray(std::span<const T> values) { WriteTypedArray(values.data(), values.size()); }
+#endif
+
+        // Note: Starts a record of the schema "fields", whose values follow with one "WriteRecordField" call per field, in schema order
+        // and of the field's type. A schema is identified by the address of "fields", which must stay valid while the writer is in use,
+        // and only written in full before its first record. Returns "false" without writing anything if records are disabled.
+        bool BeginRecord(const havSeriLiteSchemaField* fields, std::size_t numOfFields)
+        {
+            if (mOptions.mRecords == false)
+            {
+                return false;
+            }
+
+            CountValue(havSeriLiteValueType::Record);
+
+            auto it = mSchemaIds.find(fields);
+
+            if (it != mSchemaIds.end())
+            {
+                const std::uint8_t tag = static_cast<std::uint8_t>(havSeriLiteWireTag::RecordReference);
+                Append(&tag, sizeof(std::uint8_t));
+                AppendVarint(it->second);
+                return true;
+            }
+
+            const std::uint32_t schemaId = static_cast<std::uint32_t>(mSchemaIds.size());
+            mSchemaIds.emplace(fields, schemaId);
+
+            const std::uint8_t tag = static_cast<std::uint8_t>(havSeriLiteWireTag::RecordDefinition);
+            Append(&tag, sizeof(std::uint8_t));
+            AppendVarint(schemaId);
+            AppendVarint(numOfFields);
+
+            for (std::size_t i = 0; i < numOfFields; ++i)
+            {
+                AppendTag(fields[i].mType);
+                AppendVarint(fields[i].mName.size());
+                Append(fields[i].mName.data(), fields[i].mName.size());
+            }
+
+            MarkDefinition();
+
+            return true;
+        }
+
+        template<typename T>
+        inline std::enable_if_t<std::is_arithmetic_v<T>> WriteRecordField(T value)
+        {
+            if constexpr (std::is_same_v<T, bool>)
+            {
+                const std::uint8_t byte = value == true ? 1 : 0;
+                Append(&byte, sizeof(std::uint8_t));
+            }
+            else
+            {
+                Append(&value, sizeof(T));
+            }
+        }
+
+        inline void WriteRecordField(std::string_view value)
+        {
+            HAVSERILITE_STATS(mStats.mNumOfStringBytes += value.size());
+            AppendVarint(value.size());
+            AppendPayload(value.data(), value.size());
+        }
+
+        // Note: Hands the buffered output to the sink and flushes the sink. Returns "false" if any write since the last flush failed.
+        // Output of open sized containers stays buffered until the outermost one is closed, unless the sink can write back.
+        bool Flush()
+        {
+            bool result = FlushBuffer();
+
+            if (mSink != nullptr)
+            {
+                result &= mSink->Flush();
+            }
+
+            result &= !mWriteFailed;
+            mWriteFailed = false;
+
+            return result;
+        }
+
+        bool WriteFile(const std::string& fileName)
+        {
+            auto fileSink = std::make_unique<havSeriLiteFileSink>();
+
+            if (fileSink->Open(fileName) == false)
+            {
+                std::cerr << "Unable to write file: " << fileName << std::endl;
+                return false;
+            }
+
+            if (mOptions.mCompressedBlockSize > 0)
+            {
+                SetSink(std::make_unique<havSeriLiteBlockSink>(std::move(fileSink), mOptions.mCompressedBlockSize));
+                return true;
+            }
+
+            SetSink(std::move(fileSink));
+
+            return true;
+        }
+
+        void SetSink(std::unique_ptr<havSeriLiteSink, havSeriLiteSinkDeleter> sink)
+        {
+            FlushBuffer(true);
+            Flush();
+
+            mSink = std::move(sink);
+            mBuffer.reserve(mOptions.mBufferCapacity);
+            mShardSink = nullptr;
+            ResetStream();
+        }
+
+        // Note: Like "SetSink", but "sink" is borrowed and must outlive the writer (or the next "Reset"/"SetSink"). The buffers of the
+        // writer are kept, so a long-lived writer reset for every message encodes small messages without allocating, unless strings
+        // are interned or records are written, whose definitions start over in every stream.
+        void Reset(havSeriLiteSink& sink)
+        {
+            SetSink(std::unique_ptr<havSeriLiteSink, havSeriLiteSinkDeleter>(&sink, havSeriLiteSinkDeleter(false)));
+        }
+
+        // Note: Starts a new stream that is appended to "target" (e.g. a network send buffer) on every flush.
+        void Reset(std::vector<char>& target)
+        {
+            // Note: The pending output still belongs to the previous target.
+            FlushBuffer(true);
+            Flush();
+
+            if (mTargetSink == nullptr)
+            {
+                mTargetSink = std::make_unique<havSeriLiteMemorySink>(target);
+            }
+            else
+            {
+                mTargetSink->SetTarget(target);
+            }
+
+            Reset(*mTargetSink);
+        }
+
+        inline havSeriLiteSink* GetSink() const { return mSink.get(); }
+
+        // Note: Statistics collected since construction or "ResetStats", all zero unless "HAVSERILITE_ENABLE_STATS" is 1.
+        inline const havSeriLiteStats& GetStats() const
+        {
+#if HAVSERILITE_ENABLE_STATS
+            return mStats;
+#else
+            static const havSeriLiteStats stats;
+            return stats;
+#endif
+        }
+
+        inline void ResetStats() { HAVSERILITE_STATS(mStats = havSeriLiteStats {}); }
+
+        // Note: Creates an independent in-memory writer, e.g. for another thread, whose values can be appended to this writer with
+        // "WriteShard". Shards use the same encoding but are written without a header, a string dictionary and records, as their ids
+        // are only known to this writer. Typed arrays keep the padding of the shard, so their payloads may not be aligned in the combined output.
+        havSeriLiteWriter CreateShard() const
+        {
+            havSeriLiteWriterOptions options = mOptions;
+            options.mInternKeys = false;
+            options.mInternValues = false;
+            options.mRecords = false;
+
+            auto shardSink = std::make_unique<havSeriLiteMemorySink>();
+            havSeriLiteMemorySink* shardSinkPointer = shardSink.get();
+
+            return havSeriLiteWriter(std::move(shardSink), options, shardSinkPointer);
+        }
+
+        // Note: Appends the values of shards created with "CreateShard", in order, as if they had been written to this writer.
+        // All containers of the shards must be closed. The shards are cleared and can be reused. Unless sized containers are held in
+        // the buffer, the shard output is handed to the sink together with the pending bytes in a single vectored write.
+        bool WriteShards(havSeriLiteWriter* shards, std::size_t numOfShards)
+        {
+            std::vector<havSeriLiteBufferView> buffers;
+            buffers.reserve(numOfShards + 1);
+            buffers.push_back(havSeriLiteBufferView { mBuffer.data(), mBuffer.size() });
+
+            std::uint64_t numOfBytes = 0;
+            bool result = true;
+
+            for (std::size_t i = 0; i < numOfShards; ++i)
+            {
+                havSeriLiteWriter& shard = shards[i];
+
+                if (shard.mShardSink == nullptr || shard.mContainers.empty() == false)
+                {
+                    std::cerr << "Unable to write shard: not created with \"CreateShard\" or containers left open!" << std::endl;
+                    return false;
+                }
+
+                result &= shard.FlushBuffer() && !shard.mWriteFailed;
+
+                const std::vector<char>& data = shard.mShardSink->GetData();
+                buffers.push_back(havSeriLiteBufferView { data.data(), data.size() });
+                numOfBytes += data.size();
+                CountValues(shard.mNumOfValues);
+            }
+
+            if (mNumOfSizedContainers > 0 || mSink == nullptr)
+            {
+                for (std::size_t i = 1; i < buffers.size(); ++i)
+                {
+                    Append(buffers[i].mData, buffers[i].mSize);
+                }
+            }
+            else
+            {
+                WriteToSink(buffers.data(), buffers.size());
+
+                mNumOfBytesFlushed += mBuffer.size() + numOfBytes;
+                mBuffer.clear();
+            }
+
+            for (std::size_t i = 0; i < numOfShards; ++i)
+            {
+                shards[i].mShardSink->Clear();
+                shards[i].mNumOfBytesFlushed = 0;
+                shards[i].mNumOfValues = 0;
+                shards[i].mWriteFailed = false;
+            }
+
+            return result;
+        }
+
+        inline bool WriteShard(havSeriLiteWriter& shard) { return WriteShards(&shard, 1); }
+
+        void CloseFile()
+        {
+            FlushBuffer(true);
+            Flush();
+            mSink.reset(nullptr);
+        }
+
+    private:
+        friend class havSeriLiteLogWriter;
+
+        havSeriLiteWriter(std::unique_ptr<havSeriLiteSink> sink, const havSeriLiteWriterOptions& options, havSeriLiteMemorySink* shardSink) : mSink(std::move(sink)), mOptions(options), mNumOfSizedContainers(0), mNumOfBytesFlushed(0), mWriteFailed(false), mShardSink(shardSink)
+        {
+            mBuffer = havSeriLiteBufferPool::Acquire(mOptions.mBufferCapacity);
+        }
+
+        struct havSeriLiteContainerState
+        {
+            havSeriLiteValueType mType;
+            // Note: Offset of the size header in the stream, or "NoHeader" for containers written without one.
+            std::uint64_t mHeaderOffset;
+            std::uint64_t mCount;
+            bool mDefinesStrings;
+            // Note: Whether the output is held in the buffer until the container is closed, as the sink cannot write back.
+            bool mHeld;
+        };
+
+        static constexpr std::uint64_t NoHeader = static_cast<std::uint64_t>(-1);
+        static constexpr std::size_t SizeHeaderSize = 2 * sizeof(std::uint64_t);
+
+        inline void CountValues(std::uint64_t numOfValues)
+        {
+            (mContainers.empty() == false ? mContainers.back().mCount : mNumOfValues) += numOfValues;
+        }
+
+        inline void CountValue([[maybe_unused]] havSeriLiteValueType type)
+        {
+            HAVSERILITE_STATS(CountValueType(type));
+            CountValues(1);
+        }
+
+        void BeginContainer(havSeriLiteValueType type, bool sized)
+        {
+            std::uint8_t tag = static_cast<std::uint8_t>(type);
+            if (sized == true)
+            {
+                tag |= static_cast<std::uint8_t>(havSeriLiteWireTag::SizedFlag);
+            }
+            Append(&tag, sizeof(std::uint8_t));
+
+            std::uint64_t headerOffset = NoHeader;
+            bool held = false;
+
+            if (sized == true)
+            {
+                // Note: Unless the sink can write back, sized containers are held in the buffer until the outermost one is closed,
+                // so their headers can be backpatched there.
+                held = mSink == nullptr || mSink->CanWriteBack() == false;
+
+                if (held == true)
+                {
+                    ++mNumOfSizedContainers;
+                }
+
+                const char header[SizeHeaderSize] = {};
+                Append(header, SizeHeaderSize);
+                headerOffset = mNumOfBytesFlushed + mBuffer.size() - SizeHeaderSize;
+            }
+
+            mContainers.push_back(havSeriLiteContainerState { type, headerOffset, 0, false, held });
+            HAVSERILITE_STATS(mStats.mMaxDepthLevel = std::max(mStats.mMaxDepthLevel, static_cast<std::int32_t>(mContainers.size())));
+        }
+
+        void EndContainer()
+        {
+            if (mContainers.empty() == true)
+            {
+                return;
+            }
+
+            const havSeriLiteContainerState container = mContainers.back();
+            mContainers.pop_back();
+
+            if (container.mHeaderOffset == NoHeader)
+            {
+                return;
+            }
+
+            // Note: The byte length covers everything after the header up to and including the closing tag.
+            const std::uint64_t streamSize = mNumOfBytesFlushed + mBuffer.size();
+            const std::uint64_t byteSize = streamSize - (container.mHeaderOffset + SizeHeaderSize);
+            std::uint64_t count = container.mType == havSeriLiteValueType::Object ? container.mCount / 2 : container.mCount;
+            if (container.mDefinesStrings == true)
+            {
+                count |= havSeriLiteContainerData::DefinesStringsFlag;
+            }
+            char header[SizeHeaderSize];
+            std::memcpy(header, &byteSize, sizeof(std::uint64_t));
+            std::memcpy(header + sizeof(std::uint64_t), &count, sizeof(std::uint64_t));
+
+            if (container.mHeaderOffset >= mNumOfBytesFlushed)
+            {
+                std::memcpy(&mBuffer[static_cast<std::size_t>(container.mHeaderOffset - mNumOfBytesFlushed)], header, SizeHeaderSize);
+            }
+            else if (container.mHeld == false && mSink != nullptr)
+            {
+                // Note: The header was already handed to the sink, which overwrites it in place.
+                mWriteFailed |= !mSink->WriteBack(mNumOfBytesFlushed - container.mHeaderOffset, header, SizeHeaderSize);
+            }
+
+            if (container.mHeld == true)
+            {
+                --mNumOfSizedContainers;
+            }
+        }
+
+        // Note: Discards the buffered output and starts a new stream, in which dictionary strings and record schemas are defined again.
+        void ResetStream()
+        {
+            mBuffer.clear();
+            mContainers.clear();
+            mNumOfSizedContainers = 0;
+            mNumOfBytesFlushed = 0;
+            mNumOfValues = 0;
+            mStringIds.clear();
+            mStrings.clear();
+            mSchemaIds.clear();
+            WriteHeader();
+        }
+
+        void WriteHeader()
+        {
+            std::uint8_t formatFlags = 0;
+
+            if (mOptions.mCompact == true)
+            {
+                formatFlags |= static_cast<std::uint8_t>(havSeriLiteFormatFlag::Compact);
+            }
+
+            if (mOptions.mInternKeys == true || mOptions.mInternValues == true)
+            {
+                formatFlags |= static_cast<std::uint8_t>(havSeriLiteFormatFlag::Dictionary);
+            }
+
+            if (mOptions.mRecords == true)
+            {
+                formatFlags |= static_cast<std::uint8_t>(havSeriLiteFormatFlag::Records);
+            }
+
+            // Note: Without any optional encoding the output stays readable by older versions of the library.
+            if (formatFlags == 0)
+            {
+                return;
+            }
+
+            const char header[havSeriLiteHeader::Size] = { havSeriLiteHeader::Magic[0], havSeriLiteHeader::Magic[1], havSeriLiteHeader::Magic[2], static_cast<char>(havSeriLiteHeader::Version), static_cast<char>(formatFlags) };
+            Append(header, sizeof(header));
+        }
+
+        inline void AppendTag(havSeriLiteValueType type)
+        {
+            const std::uint8_t tag = static_cast<std::uint8_t>(type);
+            Append(&tag, sizeof(std::uint8_t));
+        }
+
+        inline void AppendBoolean(bool value)
+        {
+            if (mOptions.mCompact == true)
+            {
+                const std::uint8_t tag = static_cast<std::uint8_t>(value == true ? havSeriLiteWireTag::True : havSeriLiteWireTag::False);
+                Append(&tag, sizeof(std::uint8_t));
+                return;
+            }
+
+            AppendTag(havSeriLiteValueType::Boolean);
+            Append(&value, sizeof(bool));
+        }
+
+        template<typename T>
+        inline void AppendInteger(havSeriLiteValueType type, T value)
+        {
+            if (mOptions.mCompact == false)
+            {
+                AppendTag(type);
+                Append(&value, sizeof(T));
+                return;
+            }
+
+            std::uint64_t encoded = 0;
+            if constexpr (std::is_signed_v<T>)
+            {
+                encoded = ZigZagEncode(value);
+            }
+            else
+            {
+                encoded = value;
+            }
+
+            if (encoded < 16)
+            {
+                const std::uint8_t tag = static_cast<std::uint8_t>(static_cast<std::uint8_t>(havSeriLiteWireTag::SmallInteger) | ((static_cast<std::uint8_t>(type) - static_cast<std::uint8_t>(havSeriLiteValueType::Int32)) << 4) | encoded);
+                Append(&tag, sizeof(std::uint8_t));
+                return;
+            }
+
+            AppendTag(type);
+            AppendVarint(encoded);
+        }
+
+        inline void AppendLength(std::uint64_t length)
+        {
+            if (mOptions.mCompact == true)
+            {
+                AppendVarint(length);
+                return;
+            }
+
+            const std::uint32_t fixedLength = static_cast<std::uint32_t>(length);
+            Append(&fixedLength, sizeof(std::uint32_t));
+        }
+
+        inline void AppendCount(std::uint64_t count)
+        {
+            if (mOptions.mCompact == true)
+            {
+                AppendVarint(count);
+                return;
+            }
+
+            Append(&count, sizeof(std::uint64_t));
+        }
+
+        // Note: Absolute position in the output stream.
+        inline std::uint64_t GetPosition() const
+        {
+            return mNumOfBytesFlushed + mBuffer.size();
+        }
+
+        inline void AppendVarint(std::uint64_t value)
+        {
+            char bytes[10];
+            std::size_t size = 0;
+
+            while (value >= 0x80)
+            {
+                bytes[size++] = static_cast<char>((value & 0x7F) | 0x80);
+                value >>= 7;
+            }
+
+            bytes[size++] = static_cast<char>(value);
+            Append(bytes, size);
+        }
+
+        inline void AppendString(std::string_view value, bool intern = false)
+        {
+            HAVSERILITE_STATS(mStats.mNumOfStringBytes += value.size());
+
+            if (mOptions.mCompact == true && value.empty() == true)
+            {
+                const std::uint8_t tag = static_cast<std::uint8_t>(havSeriLiteWireTag::EmptyString);
+                Append(&tag, sizeof(std::uint8_t));
+                return;
+            }
+
+            if (intern == true && AppendInternedString(value) == true)
+            {
+                return;
+            }
+
+            AppendTag(havSeriLiteValueType::String);
+            AppendLength(value.size());
+            AppendPayload(value.data(), value.size());
+        }
+
+        // Note: Writes a reference to a string written before, or its definition if there is still room in the dictionary.
+        bool AppendInternedString(std::string_view value)
+        {
+            auto it = mStringIds.find(value);
+
+            if (it != mStringIds.end())
+            {
+                if (it->second < 64)
+                {
+                    const std::uint8_t tag = static_cast<std::uint8_t>(static_cast<std::uint8_t>(havSeriLiteWireTag::SmallStringReference) | it->second);
+                    Append(&tag, sizeof(std::uint8_t));
+                }
+                else
+                {
+                    const std::uint8_t tag = static_cast<std::uint8_t>(havSeriLiteWireTag::StringReference);
+                    Append(&tag, sizeof(std::uint8_t));
+                    AppendVarint(it->second);
+                }
+
+                return true;
+            }
+
+            if (mStrings.size() >= mOptions.mMaxInternedStrings)
+            {
+                return false;
+            }
+
+            const std::uint32_t stringId = static_cast<std::uint32_t>(mStrings.size());
+            mStrings.emplace_back(value);
+            HAVSERILITE_STATS(++mStats.mNumOfStringAllocations);
+            mStringIds.emplace(mStrings.back(), stringId);
+
+            const std::uint8_t tag = static_cast<std::uint8_t>(havSeriLiteWireTag::StringDefinition);
+            Append(&tag, sizeof(std::uint8_t));
+            AppendVarint(stringId);
+            AppendLength(value.size());
+            AppendPayload(value.data(), value.size());
+
+            MarkDefinition();
+
+            return true;
+        }
+
+        // Note: Marks the open containers as holding a definition, so readers do not jump over them. Ancestors of a marked container are already marked.
+        inline void MarkDefinition()
+        {
+            for (auto container = mContainers.rbegin(); container != mContainers.rend() && container->mDefinesStrings == false; ++container)
+            {
+                container->mDefinesStrings = true;
+            }
+        }
+
+        inline void Append(const void* data, std::size_t size)
+        {
+            if (mBuffer.size() + size > mOptions.mBufferCapacity && mNumOfSizedContainers == 0)
+            {
+                FlushBuffer();
+            }
+
+            const char* bytes = static_cast<const char*>(data);
+            mBuffer.insert(mBuffer.end(), bytes, bytes + size);
+        }
+
+        // Note: Large payloads bypass the buffer and are handed to the sink together with the pending bytes in a single vectored write.
+        inline void AppendPayload(const char* data, std::size_t size)
+        {
+            if (size < mOptions.mBufferCapacity / 2 || mSink == nullptr || mNumOfSizedContainers > 0)
+            {
+                Append(data, size);
+                return;
+            }
+
+            havSeriLiteBufferView buffers[] = { { mBuffer.data(), mBuffer.size() }, { data, size } };
+
+            WriteToSink(buffers, 2);
+
+            mNumOfBytesFlushed += mBuffer.size() + size;
+            mBuffer.clear();
+        }
+
+        // Note: While sized containers are held the buffer is only handed over when "force" is set, leaving their sizes unknown (zero).
+        bool FlushBuffer(bool force = false)
+        {
+            if (mBuffer.empty() == true || (mNumOfSizedContainers > 0 && force == false))
+            {
+                return true;
+            }
+
+            const havSeriLiteBufferView buffer { mBuffer.data(), mBuffer.size() };
+            const bool result = WriteToSink(&buffer, 1);
+
+            mNumOfBytesFlushed += mBuffer.size();
+            mBuffer.clear();
+
+            return result;
+        }
+
+        // Note: A failed write is remembered and reported by the next "Flush".
+        bool WriteToSink(const havSeriLiteBufferView* buffers, std::size_t numOfBuffers)
+        {
+            HAVSERILITE_STATS(havSeriLiteStatsTimer timer(mStats.mFlushTime));
+            HAVSERILITE_STATS(++mStats.mNumOfFlushes);
+
+            const bool result = mSink != nullptr && (numOfBuffers == 1 ? mSink->Write(buffers[0].mData, buffers[0].mSize) : mSink->WriteVector(buffers, numOfBuffers));
+
+            if (result == false)
+            {
+                mWriteFailed = true;
+                HAVSERILITE_STATS(++mStats.mNumOfErrors);
+            }
+
+#if HAVSERILITE_ENABLE_STATS
+            for (std::size_t i = 0; i < numOfBuffers; ++i)
+            {
+                mStats.mNumOfBytes += buffers[i].mSize;
+            }
+#endif
+
+            return result;
+        }
+
+#if HAVSERILITE_ENABLE_STATS
+        inline void CountValueType(havSeriLiteValueType type)
+        {
+            ++mStats.mNumOfValues[static_cast<std::size_t>(type)];
+        }
+#endif
+
+        std::unique_ptr<havSeriLiteSink, havSeriLiteSinkDeleter> mSink;
+        // Note: Sink of the buffers handed to "Reset", kept to be retargeted for the next one.
+        std::unique_ptr<havSeriLiteMemorySink> mTargetSink;
+        std::vector<char> mBuffer;
+        std::vector<havSeriLiteContainerState> mContainers;
+        havSeriLiteWriterOptions mOptions;
+        // Note: Number of open sized containers held in the buffer (see "havSeriLiteContainerState::mHeld").
+        std::size_t mNumOfSizedContainers;
+        std::uint64_t mNumOfBytesFlushed;
+        bool mWriteFailed;
+        // Note: Dictionary strings by id. A deque keeps the strings in place, so the map can refer to them with views.
+        std::deque<std::string> mStrings;
+        std::unordered_map<std::string_view, std::uint32_t> mStringIds;
+        // Note: Record schema ids by the address of their fields (see "BeginRecord").
+        std::unordered_map<const havSeriLiteSchemaField*, std::uint32_t> mSchemaIds;
+        // Note: Number of top-level values, which is added to the enclosing container when a shard is spliced.
+        std::uint64_t mNumOfValues = 0;
+        // Note: Output of a shard created with "CreateShard", "nullptr" for other writers.
+        havSeriLiteMemorySink* mShardSink = nullptr;
+#if HAVSERILITE_ENABLE_STATS
+        havSeriLiteStats mStats;
+#endif
+    };
+
+    // Note: Reads the records of a log written by "havSeriLiteLogWriter" one at a time. Reading stops before the first record that is
+    // incomplete, e.g. because it is still being written, and continues from there on the next call, so a growing log can be tailed.
+    class havSeriLiteLogReader
+    {
+    public:
+        havSeriLiteLogReader() : mFileStream(nullptr, std::fclose), mOffset(0), mHeaderRead(false), mNeedsSeek(true), mDamaged(false) {}
+
+        havSeriLiteLogReader(const havSeriLiteLogReader&) = delete;
+        havSeriLiteLogReader& operator=(const havSeriLiteLogReader&) = delete;
+
+        // Note: Starts reading at "offset", which is either zero or a value of "GetOffset" (e.g. saved to resume after a restart).
+        bool Open(const std::string& fileName, std::uint64_t offset = 0)
+        {
+            Close();
+
+#ifdef _WIN32
+            std::unique_ptr<std::FILE, decltype(&std::fclose)> fileStream(_wfopen(&ConvertStringToWString(fileName)[0], L"rb"), std::fclose);
+#else
+            std::unique_ptr<std::FILE, decltype(&std::fclose)> fileStream(std::fopen(fileName.c_str(), "rb"), std::fclose);
+#endif
+
+            if (fileStream == nullptr)
+            {
+                std::cerr << "Unable to read file: " << fileName << "!" << std::endl;
+                return false;
+            }
+
+            mFileStream = std::move(fileStream);
+            mOffset = offset;
+
+            return true;
+        }
+
+        void Close()
+        {
+            mFileStream.reset(nullptr);
+            mRecord.clear();
+            mOffset = 0;
+            mHeaderRead = false;
+            mNeedsSeek = true;
+            mDamaged = false;
+        }
+
+        // Note: Reads the next record and returns "false" if there is none yet, or if the log is damaged (see "IsDamaged").
+        bool ReadRecord()
+        {
+            if (mFileStream == nullptr || mDamaged == true || (mHeaderRead == false && ReadHeader() == false))
+            {
+                return false;
+            }
+
+            if (mNeedsSeek == true)
+            {
+                if (Seek(mOffset) == false)
+                {
+                    return false;
+                }
+
+                mNeedsSeek = false;
+            }
+
+            std::uint32_t recordHeader[2];
+
+            if (ReadExactly(reinterpret_cast<char*>(recordHeader), sizeof(recordHeader)) == false)
+            {
+                return false;
+            }
+
+            if (recordHeader[0] == 0 || recordHeader[0] > havSeriLiteLogFrame::MaxRecordSize)
+            {
+                return FailRecord();
+            }
+
+            mRecord.resize(recordHeader[0]);
+
+            if (ReadExactly(mRecord.data(), mRecord.size()) == false)
+            {
+                mRecord.clear();
+                return false;
+            }
+
+            if (ComputeCrc32c(mRecord.data(), mRecord.size(), ComputeCrc32c(reinterpret_cast<const char*>(&recordHeader[0]), sizeof(std::uint32_t))) != recordHeader[1])
+            {
+                return FailRecord();
+            }
+
+            mOffset += havSeriLiteLogFrame::RecordHeaderSize + recordHeader[0];
+
+            return true;
+        }
+
+        // Note: Payload of the last record read, a complete havSeriLite stream to be read with "havSeriLiteReader". The view is only
+        // valid until the next call to "ReadRecord".
+        inline std::string_view GetRecord() const { return std::string_view(mRecord.data(), mRecord.size()); }
+
+        // Note: Offset behind the last record read, where reading continues. Zero until the header has been read.
+        inline std::uint64_t GetOffset() const { return mOffset; }
+
+        // Note: "true" if reading stopped at a record that is complete but fails its checksum, or at an invalid header. Unlike a record
+        // that is still being written, such a record will not become valid by waiting.
+        inline bool IsDamaged() const { return mDamaged; }
+
+        // Note: "true" if the damaged record runs to the end of the file, as a record torn by a crash does: its payload ends exactly
+        // at the end of the file, or its size is invalid and only zero bytes follow. Damage followed by further data is not.
+        bool IsDamagedAtEnd()
+        {
+            if (mDamaged == false || mHeaderRead == false || Seek(mOffset) == false)
+            {
+                return false;
+            }
+
+            std::uint32_t size = 0;
+            const std::size_t numOfBytes = std::fread(&size, sizeof(char), sizeof(size), mFileStream.get());
+            mNeedsSeek = true;
+
+            if (numOfBytes == sizeof(size) && size > 0 && size <= havSeriLiteLogFrame::MaxRecordSize)
+            {
+                return Seek(mOffset + havSeriLiteLogFrame::RecordHeaderSize + size) == true && std::fgetc(mFileStream.get()) == EOF;
+            }
+
+            if (Seek(mOffset) == false)
+            {
+                return false;
+            }
+
+            int character;
+
+            while ((character = std::fgetc(mFileStream.get())) == 0)
+            {
+            }
+
+            return character == EOF && std::ferror(mFileStream.get()) == 0;
+        }
+
+    private:
+        bool ReadHeader()
+        {
+            char header[havSeriLiteLogFrame::HeaderSize];
+
+            if (Seek(0) == false)
+            {
+                return false;
+            }
+
+            const std::size_t numOfBytes = std::fread(header, sizeof(char), sizeof(header), mFileStream.get());
+
+            // Note: A header cut short is only accepted as long as what is there matches.
+            if (std::memcmp(header, havSeriLiteLogFrame::Magic, std::min(numOfBytes, sizeof(havSeriLiteLogFrame::Magic))) != 0 ||
+                (numOfBytes > sizeof(havSeriLiteLogFrame::Magic) && static_cast<std::uint8_t>(header[sizeof(havSeriLiteLogFrame::Magic)]) > havSeriLiteLogFrame::Version))
+            {
+                std::cerr << "Error: Invalid log file header!" << std::endl;
+                mDamaged = true;
+                return false;
+            }
+
+            mNeedsSeek = true;
+
+            if (numOfBytes < sizeof(header))
+            {
+                return false;
+            }
+
+            mHeaderRead = true;
+            mOffset = std::max<std::uint64_t>(mOffset, havSeriLiteLogFrame::HeaderSize);
+            mNeedsSeek = mOffset != havSeriLiteLogFrame::HeaderSize;
+
+            return true;
+        }
+
+        // Note: Seeking clears the end-of-file state, so data appended since the last read becomes visible.
+        bool Seek(std::uint64_t offset)
+        {
+#ifdef _WIN32
+            return offset <= static_cast<std::uint64_t>(std::numeric_limits<long long>::max()) && _fseeki64(mFileStream.get(), static_cast<long long>(offset), SEEK_SET) == 0;
+#else
+            return offset <= static_cast<std::uint64_t>(std::numeric_limits<off_t>::max()) && fseeko(mFileStream.get(), static_cast<off_t>(offset), SEEK_SET) == 0;
+#endif
+        }
+
+        bool ReadExactly(char* data, std::size_t size)
+        {
+            if (std::fread(data, sizeof(char), size, mFileStream.get()) != size)
+            {
+                mNeedsSeek = true;
+                return false;
+            }
+
+            return true;
+        }
+
+        bool FailRecord()
+        {
+            std::cerr << "Error: Corrupt log record at offset " << mOffset << "!" << std::endl;
+            mRecord.clear();
+            mDamaged = true;
+            return false;
+        }
+
+        std::unique_ptr<std::FILE, decltype(&std::fclose)> mFileStream;
+        std::vector<char> mRecord;
+        std::uint64_t mOffset;
+        bool mHeaderRead;
+        // Note: Set after a short read, whose end-of-file state has to be cleared before reading on.
+        bool mNeedsSeek;
+        bool mDamaged;
+    };
+
+    // Note: Appends top-level values to a log file as checksummed records (see "havSeriLiteLogFrame"), so a file can be extended by
+    // later runs without rewriting it, and a crash loses at most the records not committed yet. Read logs with "havSeriLiteLogReader".
+    class havSeriLiteLogWriter
+    {
+    public:
+        explicit havSeriLiteLogWriter(const havSeriLiteLogOptions& options = havSeriLiteLogOptions {}) : mOptions(options), mWriter(std::make_unique<havSeriLiteMemorySink>(mPending), options.mWriterOptions), mFileStream(nullptr, std::fclose), mSize(0), mNumOfPendingRecords(0) {}
+
+        ~havSeriLiteLogWriter()
+        {
+            Close();
+        }
+
+        havSeriLiteLogWriter(const havSeriLiteLogWriter&) = delete;
+        havSeriLiteLogWriter& operator=(const havSeriLiteLogWriter&) = delete;
+
+        // Note: Opens "fileName" for appending and creates it if needed. All records are verified first, and a record at the end of the
+        // file left incomplete or damaged by a crash is cut off, so new records follow the last valid one. A log damaged before its
+        // last record is not opened, as cutting it off would drop the valid records behind the damage.
+        bool Open(const std::string& fileName)
+        {
+            Close();
+
+#ifdef _WIN32
+            std::unique_ptr<std::FILE, decltype(&std::fclose)> fileStream(_wfopen(&ConvertStringToWString(fileName)[0], L"ab"), std::fclose);
+#else
+            std::unique_ptr<std::FILE, decltype(&std::fclose)> fileStream(std::fopen(fileName.c_str(), "ab"), std::fclose);
+#endif
+
+            if (fileStream == nullptr)
+            {
+                std::cerr << "Unable to write file: " << fileName << std::endl;
+                return false;
+            }
+
+            // Note: Commits are handed over in one piece, so the stdio buffer would only add a copy.
+            std::setvbuf(fileStream.get(), nullptr, _IONBF, 0);
+
+            havSeriLiteLogReader logReader;
+
+            if (logReader.Open(fileName) == false)
+            {
+                return false;
+            }
+
+            while (logReader.ReadRecord() == true)
+            {
+            }
+
+            if (logReader.IsDamaged() == true && logReader.GetOffset() == 0)
+            {
+                std::cerr << "Unable to append to file: " << fileName << " is not a log!" << std::endl;
+                return false;
+            }
+
+            if (logReader.IsDamaged() == true && logReader.IsDamagedAtEnd() == false)
+            {
+                std::cerr << "Unable to append to file: " << fileName << " is damaged at offset " << logReader.GetOffset() << "!" << std::endl;
+                return false;
+            }
+
+            mFileStream = std::move(fileStream);
+            mSize = logReader.GetOffset();
+
+            if (GetFileSize() != mSize && TruncateFile(mSize) == false)
+            {
+                std::cerr << "Error: Failed to cut off the damaged end of log file: " << fileName << "!" << std::endl;
+                mFileStream.reset(nullptr);
+                return false;
+            }
+
+            if (mSize == 0)
+            {
+                char header[havSeriLiteLogFrame::HeaderSize] = {};
+                std::memcpy(header, havSeriLiteLogFrame::Magic, sizeof(havSeriLiteLogFrame::Magic));
+                header[sizeof(havSeriLiteLogFrame::Magic)] = static_cast<char>(havSeriLiteLogFrame::Version);
+
+                if (std::fwrite(header, sizeof(char), sizeof(header), mFileStream.get()) != sizeof(header) || std::fflush(mFileStream.get()) != 0 || (mOptions.mSync == true && SyncFile() == false))
+                {
+                    std::cerr << "Error: Failed to write log file: " << fileName << "!" << std::endl;
+                    mFileStream.reset(nullptr);
+                    return false;
+                }
+
+                mSize = havSeriLiteLogFrame::HeaderSize;
+            }
+
+            return true;
+        }
+
+        // Note: Appends the values written by "function", which is called with the "havSeriLiteWriter&" to write them to, as one record.
+        // Returns "false" without appending anything if no value was written or containers were left open, or if a commit failed.
+        template<typename F>
+        bool Append(F&& function)
+        {
+            if (mFileStream == nullptr)
+            {
+                std::cerr << "Unable to append to log: no file open!" << std::endl;
+                return false;
+            }
+
+            // Note: The record is encoded straight behind its header in the pending records, which is filled in afterwards.
+            const std::size_t recordPosition = mPending.size();
+            mPending.resize(recordPosition + havSeriLiteLogFrame::RecordHeaderSize);
+
+            function(mWriter);
+
+            mWriter.FlushBuffer(true);
+
+            const std::size_t recordSize = mPending.size() - recordPosition - havSeriLiteLogFrame::RecordHeaderSize;
+            const bool complete = mWriter.mContainers.empty() == true && mWriter.mNumOfValues > 0;
+
+            mWriter.ResetStream();
+
+            if (complete == false || recordSize > havSeriLiteLogFrame::MaxRecordSize)
+            {
+                std::cerr << "Unable to append to log: no value written, containers left open or record too large!" << std::endl;
+                mPending.resize(recordPosition);
+                return false;
+            }
+
+            const std::uint32_t size = static_cast<std::uint32_t>(recordSize);
+            const std::uint32_t recordHeader[2] = { size, ComputeCrc32c(&mPending[recordPosition + havSeriLiteLogFrame::RecordHeaderSize], recordSize, ComputeCrc32c(reinterpret_cast<const char*>(&size), sizeof(size))) };
+            std::memcpy(&mPending[recordPosition], recordHeader, sizeof(recordHeader));
+
+            if (mNumOfPendingRecords++ == 0)
+            {
+                mPendingSince = std::chrono::steady_clock::now();
+            }
+
+            if (mNumOfPendingRecords >= mOptions.mMaxPendingRecords || mPending.size() >= mOptions.mMaxPendingBytes)
+            {
+                return Commit();
+            }
+
+            return CommitIfDue();
+        }
+
+        // Note: Commits the pending records if the oldest one has waited "mMaxPendingTime", e.g. called from a timer while no further
+        // records are appended.
+        bool CommitIfDue()
+        {
+            if (mNumOfPendingRecords == 0 || std::chrono::steady_clock::now() - mPendingSince < mOptions.mMaxPendingTime)
+            {
+                return true;
+            }
+
+            return Commit();
+        }
+
+        // Note: Writes the pending records with a single write, flushes them and syncs them if "mSync" is set. A failed commit is cut
+        // off the file again and keeps the records pending, so it can be retried.
+        bool Commit()
+        {
+            if (mNumOfPendingRecords == 0)
+            {
+                return true;
+            }
+
+            if (mFileStream == nullptr)
+            {
+                return false;
+            }
+
+            if (std::fwrite(mPending.data(), sizeof(char), mPending.size(), mFileStream.get()) != mPending.size() || std::fflush(mFileStream.get()) != 0 || (mOptions.mSync == true && SyncFile() == false))
+            {
+                std::cerr << "Error: Failed to commit log records!" << std::endl;
+                TruncateFile(mSize);
+                return false;
+            }
+
+            mSize += mPending.size();
+            mPending.clear();
+            mNumOfPendingRecords = 0;
+
+            return true;
+        }
+
+        // Note: Commits the pending records and closes the file.
+        bool Close()
+        {
+            const bool result = Commit();
+
+            mFileStream.reset(nullptr);
+            mPending.clear();
+            mNumOfPendingRecords = 0;
+            mSize = 0;
+
+            return result;
+        }
+
+        // Note: Size of the log up to the last committed record.
+        inline std::uint64_t GetSize() const { return mSize; }
+        inline std::size_t GetNumOfPendingRecords() const { return mNumOfPendingRecords; }
+
+    private:
+        std::uint64_t GetFileSize()
+        {
+#ifdef _WIN32
+            if (_fseeki64(mFileStream.get(), 0, SEEK_END) != 0)
+            {
+                return 0;
+            }
+
+            const long long position = _ftelli64(mFileStream.get());
+#else
+            if (fseeko(mFileStream.get(), 0, SEEK_END) != 0)
+            {
+                return 0;
+            }
+
+            const off_t position = ftello(mFileStream.get());
+#endif
+
+            return position > 0 ? static_cast<std::uint64_t>(position) : 0;
+        }
+
+        bool TruncateFile(std::uint64_t size)
+        {
+#ifdef _WIN32
+            return _chsize_s(_fileno(mFileStream.get()), static_cast<long long>(size)) == 0;
+#else
+            return ftruncate(fileno(mFileStream.get()), static_cast<off_t>(size)) == 0;
+#endif
+        }
+
+        bool SyncFile()
+        {
+#ifdef _WIN32
+            return _commit(_fileno(mFileStream.get())) == 0;
+#else
+            return fsync(fileno(mFileStream.get())) == 0;
+#endif
+        }
+
+        havSeriLiteLogOptions mOptions;
+        // Note: Committed records are written from here, the writer of the records appends to it.
+        std::vector<char> mPending;
+        havSeriLiteWriter mWriter;
+        std::unique_ptr<std::FILE, decltype(&std::fclose)> mFileStream;
+        std::uint64_t mSize;
+        std::size_t mNumOfPendingRecords;
+        std::chrono::steady_clock::time_point mPendingSince;
+    };
+
+    // Note: Converts JSON text into havSeriLite values in a single pass, calling "writer" for every value instead of building a tree.
+    // Integers become the narrowest of "Int32", "UInt32", "Int64" and "UInt64" that holds them, other numbers become "Double".
+    // Several top-level values (e.g. JSON Lines) are converted one after another.
+    class havSeriLiteJsonReader
+    {
+    public:
+        explicit havSeriLiteJsonReader(havSeriLiteWriter& writer) : mWriter(writer), mData(nullptr), mSize(0), mPosition(0) {}
+
+        havSeriLiteJsonReader(const havSeriLiteJsonReader&) = delete;
+        havSeriLiteJsonReader& operator=(const havSeriLiteJsonReader&) = delete;
+
+        // Note: On an error the values converted up to that point have already been written.
+        bool ReadBuffer(const void* data, std::size_t size)
+        {
+            if (data == nullptr && size > 0)
+            {
+                std::cerr << "Unable to read JSON: null data!" << std::endl;
+                return false;
+            }
+
+            mData = static_cast<const char*>(data);
+            mSize = size;
+            mPosition = 0;
+            mContainers.clear();
+
+            const bool result = Parse();
+
+            // Note: Close what was opened before the error, so the writer can go on with the next input. A key whose value was not
+            // converted gets a null value, so the object keeps its key/value pairs.
+            for (; mContainers.empty() == false; mContainers.pop_back())
+            {
+                if (mContainers.back().mValuePending == true)
+                {
+                    mWriter.WriteNull();
+                }
+
+                mWriter.WriteClose();
+            }
+
+            return result;
+        }
+
+        inline bool ReadBuffer(std::string_view json) { return ReadBuffer(json.data(), json.size()); }
+
+        // Note: Maps the file instead of reading it, so large files are converted without copying them first.
+        bool ReadFile(const std::string& fileName)
+        {
+            havSeriLiteMappedFile mappedFile;
+
+            if (mappedFile.Open(fileName) == false)
+            {
+                std::cerr << "Unable to read file: " << fileName << "!" << std::endl;
+                return false;
+            }
+
+            return ReadBuffer(mappedFile.GetData(), mappedFile.GetSize());
+        }
+
+        // Note: Offset of the byte at which the last conversion failed.
+        inline std::size_t GetErrorOffset() const { return mPosition; }
+
+    private:
+        bool Parse()
+        {
+            bool expectValue = true;
+
+            while (true)
+            {
+                const std::size_t valueEnd = mPosition;
+
+                SkipWhitespace();
+
+                if (expectValue == true)
+                {
+                    if (mPosition == mSize && mContainers.empty() == true)
+                    {
+                        return true;
+                    }
+
+                    if (ParseValue(expectValue) == false)
+                    {
+                        return Fail();
+                    }
+
+                    continue;
+                }
+
+                if (mContainers.empty() == true)
+                {
+                    // Note: Top-level values are separated by whitespace, only a closed container may be followed directly by the
+                    // next one. "truefalse" or "[1]2" are rejected instead of being split into two values.
+                    if (mPosition == valueEnd && mPosition < mSize && IsAdjacentContainer(valueEnd) == false)
+                    {
+                        return Fail();
+                    }
+
+                    expectValue = true;
+                    continue;
+                }
+
+                if (mPosition == mSize)
+                {
+                    return Fail();
+                }
+
+                const bool isObject = mContainers.back().mIsObject == true;
+                const char character = mData[mPosition++];
+
+                if (character == ',')
+                {
+                    if (isObject == true && ParseKey() == false)
+                    {
+                        return Fail();
+                    }
+
+                    expectValue = true;
+                }
+                else if (character == (isObject == true ? '}' : ']'))
+                {
+                    mContainers.pop_back();
+                    mWriter.WriteClose();
+                }
+                else
+                {
+                    --mPosition;
+                    return Fail();
+                }
+            }
+        }
+
+        // Note: Sets "expectValue" if the value opened a container that is not empty, as its first element (or value) follows.
+        bool ParseValue(bool& expectValue)
+        {
+            expectValue = false;
+
+            if (mPosition == mSize)
+            {
+                return false;
+            }
+
+            switch (mData[mPosition])
+            {
+                case '{':
+                    {
+                        ++mPosition;
+                        mWriter.WriteObject();
+                        SetValuePending(false);
+                        mContainers.push_back(havSeriLiteJsonContainer { true, false });
+                        SkipWhitespace();
+
+                        if (mPosition < mSize && mData[mPosition] == '}')
+                        {
+                            ++mPosition;
+                            mContainers.pop_back();
+                            mWriter.WriteClose();
+                            return true;
+                        }
+
+                        expectValue = true;
+                        return ParseKey();
+                    }
+                case '[':
+                    {
+                        ++mPosition;
+                        mWriter.WriteArray();
+                        SetValuePending(false);
+                        mContainers.push_back(havSeriLiteJsonContainer { false, false });
+                        SkipWhitespace();
+
+                        if (mPosition < mSize && mData[mPosition] == ']')
+                        {
+                            ++mPosition;
+                            mContainers.pop_back();
+                            mWriter.WriteClose();
+                            return true;
+                        }
+
+                        expectValue = true;
+                        return true;
+                    }
+                default:
+                    break;
+            }
+
+            if (ParseScalar() == false)
+            {
+                return false;
+            }
+
+            SetValuePending(false);
+
+            return true;
+        }
+
+        // Note: Writes nothing unless the whole scalar is valid.
+        bool ParseScalar()
+        {
+            switch (mData[mPosition])
+            {
+                case '"':
+                    {
+                        std::string_view value;
+
+                        if (ParseString(value) == false)
+                        {
+                            return false;
+                        }
+
+                        mWriter.WriteString(value);
+                        return true;
+                    }
+                case 't': return ParseLiteral("true") == true ? (mWriter.WriteBool(true), true) : false;
+                case 'f': return ParseLiteral("false") == true ? (mWriter.WriteBool(false), true) : false;
+                case 'n': return ParseLiteral("null") == true ? (mWriter.WriteNull(), true) : false;
+                default:  return ParseNumber();
+            }
+        }
+
+        // Note: Parses an object key and the following colon.
+        bool ParseKey()
+        {
+            SkipWhitespace();
+
+            std::string_view key;
+
+            if (mPosition == mSize || mData[mPosition] != '"' || ParseString(key) == false)
+            {
+                return false;
+            }
+
+            mWriter.WriteString(key);
+            SetValuePending(true);
+
+            SkipWhitespace();
+
+            if (mPosition == mSize || mData[mPosition] != ':')
+            {
+                return false;
+            }
+
+            ++mPosition;
+
+            return true;
+        }
+
+        inline bool ParseLiteral(std::string_view literal)
+        {
+            if (mSize - mPosition < literal.size() || std::memcmp(mData + mPosition, literal.data(), literal.size()) != 0)
+            {
+                return false;
+            }
+
+            mPosition += literal.size();
+
+            return true;
+        }
+
+        // Note: Strings without escapes are returned as views into the input. Quotes, backslashes and control characters are found
+        // eight bytes at a time.
+        bool ParseString(std::string_view& value)
+        {
+            const std::size_t start = ++mPosition;
+
+            while (true)
+            {
+                mPosition += ScanJsonPlainChunks(mData + mPosition, mSize - mPosition);
+
+                if (mPosition == mSize)
+                {
+                    return false;
+                }
+
+                const unsigned char character = static_cast<unsigned char>(mData[mPosition]);
+
+                if (character == '"')
+                {
+                    value = std::string_view { mData + start, mPosition - start };
+                    ++mPosition;
+                    return true;
+                }
+
+                if (character == '\\')
+                {
+                    mEscaped.assign(mData + start, mPosition - start);
+
+                    if (ParseEscapedString() == false)
+                    {
+                        return false;
+                    }
+
+                    value = mEscaped;
+                    return true;
+                }
+
+                if (character < 0x20)
+                {
+                    return false;
+                }
+
+                ++mPosition;
+            }
+        }
+
+        // Note: Continues a string at its first escape sequence, collecting the unescaped characters in "mEscaped".
+        bool ParseEscapedString()
+        {
+            while (mPosition < mSize)
+            {
+                const unsigned char character = static_cast<unsigned char>(mData[mPosition++]);
+
+                if (character == '"')
+                {
+                    return true;
+                }
+
+                if (character < 0x20)
+                {
+                    return false;
+                }
+
+                if (character != '\\')
+                {
+                    mEscaped.push_back(static_cast<char>(character));
+                    continue;
+                }
+
+                if (mPosition == mSize)
+                {
+                    return false;
+                }
+
+                switch (mData[mPosition++])
+                {
+                    case '"':  mEscaped.push_back('"'); break;
+                    case '\\': mEscaped.push_back('\\'); break;
+                    case '/':  mEscaped.push_back('/'); break;
+                    case 'b':  mEscaped.push_back('\b'); break;
+                    case 'f':  mEscaped.push_back('\f'); break;
+                    case 'n':  mEscaped.push_back('\n'); break;
+                    case 'r':  mEscaped.push_back('\r'); break;
+                    case 't':  mEscaped.push_back('\t'); break;
+                    case 'u':
+                        {
+                            std::uint32_t codePoint = 0;
+
+                            if (ParseHex(codePoint) == false)
+                            {
+                                return false;
+                            }
+
+                            // Note: Surrogate pairs are combined, unpaired surrogates have no UTF-8 form and become U+FFFD.
+                            std::uint32_t lowSurrogate = 0;
+
+                            if (codePoint >= 0xD800 && codePoint < 0xDC00 && mSize - mPosition >= 6 && mData[mPosition] == '\\' && mData[mPosition + 1] == 'u')
+                            {
+                                const std::size_t savedPosition = mPosition;
+                                mPosition += 2;
+
+                                if (ParseHex(lowSurrogate) == true && lowSurrogate >= 0xDC00 && lowSurrogate < 0xE000)
+                                {
+                                    codePoint = 0x10000 + ((codePoint - 0xD800) << 10) + (lowSurrogate - 0xDC00);
+                                }
+                                else
+                                {
+                                    mPosition = savedPosition;
+                                }
+                            }
+
+                            if (codePoint >= 0xD800 && codePoint < 0xE000)
+                            {
+                                codePoint = 0xFFFD;
+                            }
+
+                            AppendUtf8(codePoint);
+                        }
+                        break;
+                    default:
+                        return false;
+                }
+            }
+
+            return false;
+        }
+
+        bool ParseHex(std::uint32_t& value)
+        {
+            if (mSize - mPosition < 4)
+            {
+                return false;
+            }
+
+            auto [end, error] = std::from_chars(mData + mPosition, mData + mPosition + 4, value, 16);
+
+            if (error != std::errc() || end != mData + mPosition + 4)
+            {
+                return false;
+            }
+
+            mPosition += 4;
+
+            return true;
+        }
+
+        void AppendUtf8(std::uint32_t codePoint)
+        {
+            if (codePoint < 0x80)
+            {
+                mEscaped.push_back(static_cast<char>(codePoint));
+            }
+            else if (codePoint < 0x800)
+            {
+                mEscaped.push_back(static_cast<char>(0xC0 | (codePoint >> 6)));
+                mEscaped.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+            }
+            else if (codePoint < 0x10000)
+            {
+                mEscaped.push_back(static_cast<char>(0xE0 | (codePoint >> 12)));
+                mEscaped.push_back(static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F)));
+                mEscaped.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+            }
+            else
+            {
+                mEscaped.push_back(static_cast<char>(0xF0 | (codePoint >> 18)));
+                mEscaped.push_back(static_cast<char>(0x80 | ((codePoint >> 12) & 0x3F)));
+                mEscaped.push_back(static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F)));
+                mEscaped.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+            }
+        }
+
+        bool ParseNumber()
+        {
+            const std::size_t start = mPosition;
+            const bool isNegative = mData[mPosition] == '-';
+
+            if (isNegative == true)
+            {
+                ++mPosition;
+            }
+
+            // Note: Accumulates the integer digits, tracking overflow, so integers need no second pass.
+            const std::size_t digitsStart = mPosition;
+            std::uint64_t magnitude = 0;
+            bool overflow = false;
+
+            for (; mPosition < mSize && mData[mPosition] >= '0' && mData[mPosition] <= '9'; ++mPosition)
+            {
+                const std::uint64_t digit = static_cast<std::uint64_t>(mData[mPosition] - '0');
+                overflow |= magnitude > (std::numeric_limits<std::uint64_t>::max() - digit) / 10;
+                magnitude = magnitude * 10 + digit;
+            }
+
+            const std::size_t numOfDigits = mPosition - digitsStart;
+
+            if (numOfDigits == 0 || (numOfDigits > 1 && mData[digitsStart] == '0'))
+            {
+                return false;
+            }
+
+            bool isInteger = true;
+
+            if (mPosition < mSize && mData[mPosition] == '.')
+            {
+                isInteger = false;
+
+                if (SkipDigits(++mPosition) == false)
+                {
+                    return false;
+                }
+            }
+
+            if (mPosition < mSize && (mData[mPosition] == 'e' || mData[mPosition] == 'E'))
+            {
+                isInteger = false;
+
+                if (++mPosition < mSize && (mData[mPosition] == '+' || mData[mPosition] == '-'))
+                {
+                    ++mPosition;
+                }
+
+                if (SkipDigits(mPosition) == false)
+                {
+                    return false;
+                }
+            }
+
+            if (isInteger == true && overflow == false)
+            {
+                if (isNegative == true)
+                {
+                    if (magnitude <= std::uint64_t { 1 } << 31)
+                    {
+                        mWriter.WriteInt32(static_cast<std::int32_t>(-static_cast<std::int64_t>(magnitude)));
+                        return true;
+                    }
+
+                    if (magnitude <= std::uint64_t { 1 } << 63)
+                    {
+                        mWriter.WriteInt64(static_cast<std::int64_t>(0 - magnitude));
+                        return true;
+                    }
+                }
+                else
+                {
+                    if (magnitude <= static_cast<std::uint64_t>(std::numeric_limits<std::int32_t>::max()))
+                    {
+                        mWriter.WriteInt32(static_cast<std::int32_t>(magnitude));
+                    }
+                    else if (magnitude <= std::numeric_limits<std::uint32_t>::max())
+                    {
+                        mWriter.WriteUInt32(static_cast<std::uint32_t>(magnitude));
+                    }
+                    else if (magnitude <= static_cast<std::uint64_t>(std::numeric_limits<std::int64_t>::max()))
+                    {
+                        mWriter.WriteInt64(static_cast<std::int64_t>(magnitude));
+                    }
+                    else
+                    {
+                        mWriter.WriteUInt64(magnitude);
+                    }
+
+                    return true;
+                }
+            }
+
+            // Note: Integers beyond 64 bits are kept approximately as doubles, like most JSON parsers do. Numbers that underflow
+            // are rounded towards zero, numbers beyond the range of a double are rejected rather than kept as infinity.
+            double value = 0.0;
+            auto [end, error] = std::from_chars(mData + start, mData + mPosition, value);
+
+            if (error == std::errc::result_out_of_range)
+            {
+                const std::string text(mData + start, mPosition - start);
+                value = std::strtod(text.c_str(), nullptr);
+
+                if (value > std::numeric_limits<double>::max() || value < std::numeric_limits<double>::lowest())
+                {
+                    mPosition = start;
+                    return false;
+                }
+            }
+            else if (error != std::errc() || end != mData + mPosition)
+            {
+                return false;
+            }
+
+            mWriter.WriteDouble(value);
+
+            return true;
+        }
+
+        // Note: Marks whether the innermost object holds a key that still waits for its value.
+        inline void SetValuePending(bool valuePending)
+        {
+            if (mContainers.empty() == false)
+            {
+                mContainers.back().mValuePending = valuePending;
+            }
+        }
+
+        inline bool IsAdjacentContainer(std::size_t valueEnd) const
+        {
+            const char previous = mData[valueEnd - 1];
+            const char next = mData[valueEnd];
+
+            return (previous == '}' || previous == ']') && (next == '{' || next == '[');
+        }
+
+        inline bool SkipDigits(std::size_t& position)
+        {
+            const std::size_t start = position;
+
+            while (position < mSize && mData[position] >= '0' && mData[position] <= '9')
+            {
+                ++position;
+            }
+
+            return position > start;
+        }
+
+        inline void SkipWhitespace()
+        {
+            while (mPosition < mSize && (mData[mPosition] == ' ' || mData[mPosition] == '\n' || mData[mPosition] == '\r' || mData[mPosition] == '\t'))
+            {
+                ++mPosition;
+            }
+        }
+
+        bool Fail()
+        {
+            std::cerr << "Error: Invalid JSON at offset " << mPosition << "!" << std::endl;
+            return false;
+        }
+
+        struct havSeriLiteJsonContainer
+        {
+            bool mIsObject;
+            bool mValuePending;
+        };
+
+        havSeriLiteWriter& mWriter;
+        const char* mData;
+        std::size_t mSize;
+        std::size_t mPosition;
+        std::vector<havSeriLiteJsonContainer> mContainers;
+        std::string mEscaped;
+    };
+
+    enum class havSeriLiteVisitAction : std::uint8_t
+    {
+        Continue,
+        // Note: Returned when an array or object begins, skips its values and its "OnEnd". Returned from "OnKey", skips the key's value.
+        Skip,
+        // Note: Ends "havSeriLiteReader::Parse", which returns "false" and leaves the reader where the visitor stopped.
+        Stop
+    };
+
+    // Note: Base for visitors of "havSeriLiteReader::Parse" that continues on every event. A visitor hides the callbacks it needs with
+    // its own, which are resolved at compile time, so no call is virtual. Typed arrays and records are reported like arrays and objects.
+    // Object keys that are strings are reported with "OnKey", strings are views that are only valid during the callback.
+    struct havSeriLiteVisitor
+    {
+        inline havSeriLiteVisitAction OnNull() { return havSeriLiteVisitAction::Continue; }
+        inline havSeriLiteVisitAction OnBool(bool) { return havSeriLiteVisitAction::Continue; }
+        inline havSeriLiteVisitAction OnInt32(std::int32_t) { return havSeriLiteVisitAction::Continue; }
+        inline havSeriLiteVisitAction OnUInt32(std::uint32_t) { return havSeriLiteVisitAction::Continue; }
+        inline havSeriLiteVisitAction OnInt64(std::int64_t) { return havSeriLiteVisitAction::Continue; }
+        inline havSeriLiteVisitAction OnUInt64(std::uint64_t) { return havSeriLiteVisitAction::Continue; }
+        inline havSeriLiteVisitAction OnDouble(double) { return havSeriLiteVisitAction::Continue; }
+        inline havSeriLiteVisitAction OnString(std::string_view) { return havSeriLiteVisitAction::Continue; }
+        inline havSeriLiteVisitAction OnBytes(std::string_view) { return havSeriLiteVisitAction::Continue; }
+        inline havSeriLiteVisitAction OnKey(std::string_view) { return havSeriLiteVisitAction::Continue; }
+        inline havSeriLiteVisitAction OnBeginArray() { return havSeriLiteVisitAction::Continue; }
+        inline havSeriLiteVisitAction OnBeginObject() { return havSeriLiteVisitAction::Continue; }
+        // Note: Ends the innermost array or object.
+        inline havSeriLiteVisitAction OnEnd() { return havSeriLiteVisitAction::Continue; }
+    };
+
+    class havSeriLiteDocument;
+
+    class havSeriLiteReader
+    {
+    public:
+        // Note: Creates a reader without input, which starts reading on the first "Reset", "ReadBuffer", "ReadFile" or "ReadStream".
+        havSeriLiteReader() : mData(nullptr), mSize(0), mIndex(0), mDepthLevel(0) {}
+
+        explicit havSeriLiteReader(const std::string& fileName, havSeriLiteLoadMode loadMode = havSeriLiteLoadMode::Buffered) : mData(nullptr), mSize(0), mIndex(0), mDepthLevel(0)
+        {
+            if (ReadFile(fileName, loadMode) == false)
+            {
+                throw std::runtime_error("Unable to read file: " + fileName);
+            }
+        }
+
+        // Note: The data is borrowed, not copied, and must outlive the reader.
+        explicit havSeriLiteReader(const void* data, std::size_t size) : mData(nullptr), mSize(0), mIndex(0), mDepthLevel(0)
+        {
+            if (ReadBuffer(data, size) == false)
+            {
+                throw std::runtime_error("Unable to read buffer!");
+            }
+        }
+
+#if HAVSERILITE_HAS_SPAN
+        explicit havSeriLiteReader(std::span<const std::byte> data) : havSeriLiteReader(data.data(), data.size()) {}
+#endif
+
+        explicit havSeriLiteReader(std::unique_ptr<havSeriLiteSource> source, const havSeriLiteStreamOptions& options = {}) : mData(nullptr), mSize(0), mIndex(0), mDepthLevel(0)
+        {
+            if (ReadStream(std::move(source), options) == false)
+            {
+                throw std::runtime_error("Unable to read stream!");
+            }
+        }
+
+        // Note: Creates a reader for chunks handed over with "PushChunk" (see "ReadChunks").
+        explicit havSeriLiteReader(const havSeriLiteStreamOptions& options) : mData(nullptr), mSize(0), mIndex(0), mDepthLevel(0)
+        {
+            ReadChunks(options);
+        }
+
+        havSeriLiteReader(const havSeriLiteReader&) = delete;
+        havSeriLiteReader& operator=(const havSeriLiteReader&) = delete;
+        havSeriLiteReader(havSeriLiteReader&&) = default;
+        havSeriLiteReader& operator=(havSeriLiteReader&&) = default;
+
+        ~havSeriLiteReader()
+        {
+            havSeriLiteBufferPool::Release(std::move(mBuffer));
+        }
+
+        // Note: In streaming mode the window is refilled here, which invalidates views into the previously read values.
+        inline bool ValidityCheck(void* destination, std::uint64_t size)
+        {
+            if (size == 0 || (size > mSize - mIndex && Refill(size) == false))
+            {
+                return false;
+            }
+
+            if (destination != nullptr)
+            {
+                std::memcpy(destination, &mData[mIndex], static_cast<std::size_t>(size));
+            }
+
+            mIndex += size;
+
+            return true;
+        }
+
+        template<typename T, typename V>
+        inline std::optional<T> TryRead(const V& value, havSeriLiteValueType expectedType)
+        {
+            if (value.mType == expectedType)
+            {
+                if (auto* ptr = std::get_if<T>(&value.mData))
+                {
+                    return *ptr;
+                }
+            }
+
+            return std::nullopt;
+        }
+
+        inline std::optional<bool> TryReadBool(const havSeriLiteValue& value) { return TryRead<bool>(value, havSeriLiteValueType::Boolean); }
+        inline std::optional<std::int32_t> TryReadInt32(const havSeriLiteValue& value) { return TryRead<std::int32_t>(value, havSeriLiteValueType::Int32); }
+        inline std::optional<std::uint32_t> TryReadUInt32(const havSeriLiteValue& value) { return TryRead<std::uint32_t>(value, havSeriLiteValueType::UInt32); }
+        inline std::optional<std::int64_t> TryReadInt64(const havSeriLiteValue& value) { return TryRead<std::int64_t>(value, havSeriLiteValueType::Int64); }
+        inline std::optional<std::uint64_t> TryReadUInt64(const havSeriLiteValue& value) { return TryRead<std::uint64_t>(value, havSeriLiteValueType::UInt64); }
+        inline std::optional<double> TryReadDouble(const havSeriLiteValue& value) { return TryRead<double>(value, havSeriLiteValueType::Double); }
+        inline std::optional<std::string> TryReadString(const havSeriLiteValue& value)
+        {
+            auto* stringData = value.mType == havSeriLiteValueType::String ? std::get_if<havSeriLiteValue::havSeriLiteStringData>(&value.mData) : nullptr;
+            return stringData != nullptr ? std::optional<std::string>(stringData->mValue) : std::nullopt;
+        }
+        // Note: The view refers to the string stored in "value" and is only valid as long as "value" is alive and unchanged.
+        inline std::optional<std::string_view> TryReadStringView(const havSeriLiteValue& value)
+        {
+            auto* stringData = value.mType == havSeriLiteValueType::String ? std::get_if<havSeriLiteValue::havSeriLiteStringData>(&value.mData) : nullptr;
+            return stringData != nullptr ? std::optional<std::string_view>(stringData->mValue) : std::nullopt;
+        }
+
+        inline std::optional<bool> TryReadBool(const havSeriLiteValueView& value) { return TryRead<bool>(value, havSeriLiteValueType::Boolean); }
+        inline std::optional<std::int32_t> TryReadInt32(const havSeriLiteValueView& value) { return TryRead<std::int32_t>(value, havSeriLiteValueType::Int32); }
+        inline std::optional<std::uint32_t> TryReadUInt32(const havSeriLiteValueView& value) { return TryRead<std::uint32_t>(value, havSeriLiteValueType::UInt32); }
+        inline std::optional<std::int64_t> TryReadInt64(const havSeriLiteValueView& value) { return TryRead<std::int64_t>(value, havSeriLiteValueType::Int64); }
+        inline std::optional<std::uint64_t> TryReadUInt64(const havSeriLiteValueView& value) { return TryRead<std::uint64_t>(value, havSeriLiteValueType::UInt64); }
+        inline std::optional<double> TryReadDouble(const havSeriLiteValueView& value) { return TryRead<double>(value, havSeriLiteValueType::Double); }
+        inline std::optional<std::string> TryReadString(const havSeriLiteValueView& value)
+        {
+            auto result = TryRead<std::string_view>(value, havSeriLiteValueType::String);
+            return result ? std::optional<std::string>(*result) : std::nullopt;
+        }
+        inline std::optional<std::string_view> TryReadStringView(const havSeriLiteValueView& value) { return TryRead<std::string_view>(value, havSeriLiteValueType::String); }
+        // Note: The view refers to the data stored in "value", like with "TryReadStringView".
+        inline std::optional<std::string_view> TryReadBytes(const havSeriLiteValue& value)
+        {
+            auto* bytesData = value.mType == havSeriLiteValueType::Bytes ? std::get_if<havSeriLiteValue::havSeriLiteStringData>(&value.mData) : nullptr;
+            return bytesData != nullptr ? std::optional<std::string_view>(bytesData->mValue) : std::nullopt;
+        }
+        inline std::optional<std::string_view> TryReadBytes(const havSeriLiteValueView& value) { return TryRead<std::string_view>(value, havSeriLiteValueType::Bytes); }
+
+        // Note: Returns the dictionary id of a string value, so keys can be matched with integer compares against "FindStringId".
+        template<typename V>
+        inline std::optional<std::uint32_t> TryReadStringId(const V& value) const
+        {
+            return value.mType == havSeriLiteValueType::String && value.mStringId != havSeriLiteValueView::NoStringId ? std::optional<std::uint32_t>(value.mStringId) : std::nullopt;
+        }
+
+        // Note: Looks up the dictionary id of a string defined in the input read so far.
+        inline std::optional<std::uint32_t> FindStringId(std::string_view value) const
+        {
+            const std::unordered_map<std::string_view, std::uint32_t>& stringIds = GetDefinitions().mStringIds;
+            auto it = stringIds.find(value);
+            return it != stringIds.end() ? std::optional<std::uint32_t>(it->second) : std::nullopt;
+        }
+
+        havSeriLiteValue ReadValue()
+        {
+            havSeriLiteValue result { ReadValueView() };
+            HAVSERILITE_STATS(CountStringCopy(result));
+            return result;
+        }
+
+        // Note: Strings are returned as views into the reader's input and stay valid until the input is replaced or the reader is destroyed.
+        // In streaming mode they only stay valid until the next read. When pushed chunks end in the middle of a value, "Null" is returned,
+        // "NeedsMoreData" is set and the value is read again in full once the next chunk has been pushed.
+        havSeriLiteValueView ReadValueView()
+        {
+            mTokenStart = mIndex;
+
+            return ReadNextValue();
+        }
+
+        template<typename V>
+        inline std::optional<havSeriLiteTypedArrayData> TryReadTypedArray(const V& value)
+        {
+            return TryRead<havSeriLiteTypedArrayData>(value, havSeriLiteValueType::TypedArray);
+        }
+
+        // Note: Copies the elements of a typed array in bulk. Fails if the element type does not match "T".
+        // In streaming mode this has to happen before the next read.
+        template<typename T, typename V>
+        bool ReadTypedArray(const V& value, std::vector<T>& values)
+        {
+            auto typedArray = TryReadTypedArray(value);
+
+            if (typedArray.has_value() == false || typedArray->mElementType != havSeriLiteTypedArrayTraits<T>::ElementType || IsInWindow(typedArray->mOffset, typedArray->mCount * sizeof(T)) == false)
+            {
+                return false;
+            }
+
+            values.resize(static_cast<std::size_t>(typedArray->mCount));
+
+            if (values.empty() == false)
+            {
+                std::memcpy(values.data(), &mData[typedArray->mOffset - mBase], values.size() * sizeof(T));
+            }
+
+            return true;
+        }
+
+        template<typename V>
+        inline std::optional<havSeriLiteRecordData> TryReadRecord(const V& value)
+        {
+            return TryRead<havSeriLiteRecordData>(value, havSeriLiteValueType::Record);
+        }
+
+        // Note: Calls "function(name, field)" for every field of a record in schema order, with "field" decoded like a value read
+        // with "ReadValueView". In streaming mode this has to happen before the next read.
+        template<typename V, typename F>
+        bool ReadRecordFields(const V& value, F&& function)
+        {
+            const havSeriLiteRecordSchema* schema = nullptr;
+            const char* data = GetRecordPayload(value, schema);
+
+            if (data == nullptr)
+            {
+                return false;
+            }
+
+            for (std::size_t i = 0; i < schema->mTypes.size(); ++i)
+            {
+                const havSeriLiteValueView field = DecodeRecordField(data, schema->mTypes[i]);
+                function(std::string_view { schema->mNames[i] }, field);
+            }
+
+            return true;
+        }
+
+        // Note: Returns the field values of a record whose schema has exactly the fields "fields" (same names, types and order), or
+        // "nullptr" otherwise. The schema is only compared again when other fields are passed, so records of a known layout are decoded
+        // without looking at their schema. The values were validated when the record was read.
+        template<typename V>
+        const char* TryReadRecordPayload(const V& value, const havSeriLiteSchemaField* fields, std::size_t numOfFields)
+        {
+            const havSeriLiteRecordSchema* schema = nullptr;
+            const char* data = GetRecordPayload(value, schema);
+
+            if (data == nullptr)
+            {
+                return nullptr;
+            }
+
+            const std::uint32_t schemaId = std::get<havSeriLiteRecordData>(value.mData).mSchemaId;
+
+            if (schemaId >= mSchemaChecks.size())
+            {
+                mSchemaChecks.resize(static_cast<std::size_t>(schemaId) + 1);
+            }
+
+            havSeriLiteSchemaCheck& check = mSchemaChecks[schemaId];
+
+            if (check.mCheckedFields != fields)
+            {
+                bool matches = schema->mTypes.size() == numOfFields;
+
+                for (std::size_t i = 0; i < numOfFields && matches == true; ++i)
+                {
+                    matches = schema->mTypes[i] == fields[i].mType && schema->mNames[i] == fields[i].mName;
+                }
+
+                check.mCheckedFields = fields;
+                check.mMatchesFields = matches;
+            }
+
+            return check.mMatchesFields == true ? data : nullptr;
+        }
+
+        // Note: Skips the next value, including all nested values of an array or object. Returns "false" at the end of the current container or input.
+        bool SkipValue()
+        {
+            mTokenStart = mIndex;
+
+            if ((mIndex >= mSize && Refill(1) == false) || static_cast<havSeriLiteValueType>(mData[mIndex]) == havSeriLiteValueType::Close)
+            {
+                return false;
+            }
+
+            const std::int32_t depthLevel = mDepthLevel;
+
+            if (ReadToken() == false)
+            {
+                return false;
+            }
+
+            return SkipToDepth(depthLevel);
+        }
+
+        // Note: Skips the remaining values of the array or object at "depthLevel", including its closing tag.
+        inline bool SkipContainer(const std::int32_t& depthLevel)
+        {
+            return SkipToDepth(depthLevel - 1);
+        }
+
+        template<typename V>
+        inline std::optional<havSeriLiteContainerData> TryReadContainer(const V& value)
+        {
+            if (value.mType == havSeriLiteValueType::Array || value.mType == havSeriLiteValueType::Object)
+            {
+                if (auto* ptr = std::get_if<havSeriLiteContainerData>(&value.mData))
+                {
+                    return *ptr;
+                }
+            }
+
+            return std::nullopt;
+        }
+
+        inline bool ArrayIterator(const std::int32_t& depthLevel, havSeriLiteValue& value)
+        {
+            return Iterator(depthLevel, value);
+        }
+
+        inline bool ObjectIterator(const std::int32_t& depthLevel, havSeriLiteValue& key, havSeriLiteValue& value)
+        {
+            return Iterator(depthLevel, value, key);
+        }
+
+        inline bool ArrayIterator(const std::int32_t& depthLevel, havSeriLiteValueView& value)
+        {
+            return IteratorImpl(depthLevel, value, static_cast<havSeriLiteValueView*>(nullptr));
+        }
+
+        inline bool ObjectIterator(const std::int32_t& depthLevel, havSeriLiteValueView& key, havSeriLiteValueView& value)
+        {
+            return IteratorImpl(depthLevel, value, &key);
+        }
+
+        bool Iterator(const std::int32_t& depthLevel, havSeriLiteValue& value, std::optional<std::reference_wrapper<havSeriLiteValue>> key = std::nullopt)
+        {
+            return IteratorImpl(depthLevel, value, key.has_value() == true ? &key->get() : nullptr);
+        }
+
+        // Note: Looks up a value by a "/"-separated path of object keys and array indices (e.g. "Example/Test/TestObject" or "Values/1"),
+        // starting at the first top-level value. The reader is positioned right after the returned value, so arrays and objects can be
+        // iterated as usual. Returns a "Null" value if the path does not resolve. The index used for lookups is built on first use.
+        inline havSeriLiteValue Find(std::string_view path) { return havSeriLiteValue { FindView(path) }; }
+        inline havSeriLiteValue Find(const havSeriLiteValue& container, std::string_view path) { return havSeriLiteValue { FindView(container, path) }; }
+
+        // Note: Returns the n-th element of an array, or the n-th member value of an object, positioning the reader like "Find".
+        inline havSeriLiteValue At(const havSeriLiteValue& container, std::uint64_t n) { return havSeriLiteValue { AtView(container, n) }; }
+
+        havSeriLiteValueView FindView(std::string_view path)
+        {
+            if (BuildIndex() == false || mIndexNodes.front().mNumOfEntries == 0)
+            {
+                return havSeriLiteValueView { nullptr, havSeriLiteValueType::Null };
+            }
+
+            return FindFromEntry(0, mIndexEntries[mIndexNodes.front().mFirstEntry], path);
+        }
+
+        template<typename V>
+        havSeriLiteValueView FindView(const V& container, std::string_view path)
+        {
+            std::uint32_t node = FindIndexNode(container);
+
+            if (node == NoIndexNode)
+            {
+                return havSeriLiteValueView { nullptr, havSeriLiteValueType::Null };
+            }
+
+            while (path.empty() == false && path.front() == '/')
+            {
+                path.remove_prefix(1);
+            }
+
+            if (path.empty() == true)
+            {
+                return SeekIndexEntry(mIndexNodes[node].mParent, mIndexNodes[node].mTagOffset, node);
+            }
+
+            return FindFromNode(node, path);
+        }
+
+        template<typename V>
+        havSeriLiteValueView AtView(const V& container, std::uint64_t n)
+        {
+            std::uint32_t node = FindIndexNode(container);
+
+            if (node == NoIndexNode || n >= mIndexNodes[node].mNumOfEntries)
+            {
+                return havSeriLiteValueView { nullptr, havSeriLiteValueType::Null };
+            }
+
+            return SeekIndexEntry(node, mIndexEntries[mIndexNodes[node].mFirstEntry + n]);
+        }
+
+        // Note: Splits the elements of "container", which must be the value just read, into up to "numOfRanges" ranges of about the
+        // same number of elements. The elements are skipped without being decoded, in constant time for sized containers, and the
+        // reader is positioned after the container afterwards. Not supported for streamed input.
+        template<typename V>
+        bool SplitContainer(const V& container, std::size_t numOfRanges, std::vector<havSeriLiteElementRange>& ranges)
+        {
+            ranges.clear();
+
+            auto containerData = TryReadContainer(container);
+
+            if (containerData.has_value() == false || mStreaming == true)
+            {
+                std::cerr << "Unable to split container: " << (mStreaming == true ? "streamed input!" : "not an array or object!") << std::endl;
+                return false;
+            }
+
+            const bool isObject = container.mType == havSeriLiteValueType::Object;
+            const std::size_t maxNumOfSamples = std::max<std::size_t>(numOfRanges, 1) * 8;
+
+            // Note: Offsets are sampled every "stride" elements. The stride doubles whenever there are too many samples, so the memory
+            // used stays bounded for any number of elements.
+            std::vector<std::uint64_t> samples;
+            std::uint64_t stride = 1;
+            std::uint64_t numOfElements = 0;
+
+            mIndex = containerData->mOffset;
+            mDepthLevel = container.mDepthLevel;
+
+            while (mIndex < mSize && static_cast<havSeriLiteValueType>(mData[mIndex]) != havSeriLiteValueType::Close)
+            {
+                if (numOfElements % stride == 0)
+                {
+                    samples.push_back(GetOffset());
+
+                    if (samples.size() > maxNumOfSamples)
+                    {
+                        for (std::size_t i = 0; i < samples.size() / 2 + samples.size() % 2; ++i)
+                        {
+                            samples[i] = samples[i * 2];
+                        }
+
+                        samples.resize(samples.size() / 2 + samples.size() % 2);
+                        stride *= 2;
+                    }
+                }
+
+                if (SkipValue() == false || (isObject == true && SkipValue() == false))
+                {
+                    return false;
+                }
+
+                ++numOfElements;
+            }
+
+            const std::uint64_t containerEnd = GetOffset();
+
+            if (SkipToDepth(container.mDepthLevel - 1) == false)
+            {
+                return false;
+            }
+
+            numOfRanges = std::min<std::size_t>(std::max<std::size_t>(numOfRanges, 1), samples.size());
+
+            for (std::size_t i = 0; i < numOfRanges; ++i)
+            {
+                const std::size_t sample = i * samples.size() / numOfRanges;
+                const std::size_t nextSample = (i + 1) * samples.size() / numOfRanges;
+
+                havSeriLiteElementRange range;
+                range.mOffset = samples[sample];
+                range.mEnd = nextSample < samples.size() ? samples[nextSample] : containerEnd;
+                range.mFirstElement = sample * stride;
+                range.mNumOfElements = (nextSample < samples.size() ? nextSample * stride : numOfElements) - range.mFirstElement;
+                ranges.push_back(range);
+            }
+
+            return true;
+        }
+
+        // Note: Creates an independent reader over the elements of "range", which are read as top-level values (keys and values
+        // alternating for objects). The input, dictionary strings and record schemas are borrowed, so this reader has to outlive it
+        // and must not be reset or moved while the range reader is used.
+        havSeriLiteReader CreateRangeReader(const havSeriLiteElementRange& range) const
+        {
+            return havSeriLiteReader(*this, range);
+        }
+
+        // Note: Decodes the elements of "container", which must be the value just read, on "numOfThreads" threads (all cores if zero).
+        // The container is split with "SplitContainer" and "function(rangeReader, range)" is called once per range, with its result
+        // stored in "results" in input order. The first exception thrown by "function" is rethrown after all threads have finished.
+        template<typename V, typename F, typename R>
+        bool DecodeParallel(const V& container, F&& function, std::vector<R>& results, std::size_t numOfThreads = 0)
+        {
+            static_assert(std::is_same_v<R, bool> == false, "std::vector<bool> cannot be written from several threads");
+
+            if (numOfThreads == 0)
+            {
+                numOfThreads = std::max<std::size_t>(std::thread::hardware_concurrency(), 1);
+            }
+
+            // Note: More ranges than threads balance the load when elements differ in size.
+            std::vector<havSeriLiteElementRange> ranges;
+
+            if (SplitContainer(container, numOfThreads * 4, ranges) == false)
+            {
+                return false;
+            }
+
+            results.clear();
+            results.resize(ranges.size());
+
+            std::atomic<std::size_t> nextRange { 0 };
+            std::exception_ptr exception;
+            std::mutex exceptionMutex;
+
+            auto Worker = [&]() {
+                for (std::size_t i = nextRange++; i < ranges.size(); i = nextRange++)
+                {
+                    try
+                    {
+                        havSeriLiteReader rangeReader = CreateRangeReader(ranges[i]);
+                        results[i] = function(rangeReader, ranges[i]);
+                    }
+                    catch (...)
+                    {
+                        std::lock_guard<std::mutex> lock(exceptionMutex);
+
+                        if (exception == nullptr)
+                        {
+                            exception = std::current_exception();
+                        }
+                    }
+                }
+            };
+
+            std::vector<std::thread> threads;
+
+            for (std::size_t i = 1; i < std::min(numOfThreads, ranges.size()); ++i)
+            {
+                threads.emplace_back(Worker);
+            }
+
+            Worker();
+
+            for (std::thread& thread : threads)
+            {
+                thread.join();
+            }
+
+            if (exception != nullptr)
+            {
+                std::rethrow_exception(exception);
+            }
+
+            return true;
+        }
+
+        // Note: Writes "value" as pretty-printed JSON to "std::cout" (see "ExportJson").
+        void OutputValueType(const havSeriLiteValue& value)
+        {
+            OutputJson(value, 0);
+        }
+
+        void OutputComplexType(havSeriLiteValue value, std::int32_t depthLevel)
+        {
+            OutputJson(value, depthLevel);
+        }
+
+        // Note: Set "initialState" to "true" to reset the reader's state and start outputting from the beginning.
+        void OutputValue(havSeriLiteValue value, std::int32_t depthLevel, bool initialState = false)
+        {
+            // Note: A streamed input cannot be rewound.
+            if (initialState == true && mStreaming == false)
+            {
+                mIndex = mDataStart;
+            }
+
+            OutputJson(value, depthLevel);
+        }
+
+        // Note: Reads the next value (usually the root) and writes it as JSON to "sink", which is flushed once at the end.
+        bool ExportJson(havSeriLiteSink& sink, const havSeriLiteJsonOptions& options = havSeriLiteJsonOptions {})
+        {
+            const std::uint64_t offset = GetOffset();
+            const havSeriLiteValueView value = ReadValueView();
+
+            if (value.mType == havSeriLiteValueType::Close || (value.mType == havSeriLiteValueType::Null && IsNullValueAt(offset) == false))
+            {
+                return false;
+            }
+
+            return ExportJson(value, sink, options);
+        }
+
+        // Note: Writes "value", which has just been read, as JSON to "sink". Nested values are read from the reader.
+        template<typename V>
+        bool ExportJson(const V& value, havSeriLiteSink& sink, const havSeriLiteJsonOptions& options = havSeriLiteJsonOptions {})
+        {
+            HAVSERILITE_STATS(havSeriLiteStatsTimer timer(mStats.mDecodeTime));
+
+            havSeriLiteJsonWriter json(sink, options);
+            const bool result = WriteJson(json, value);
+
+            return json.Flush() == true && result == true;
+        }
+
+        // Note: Reads the next value (usually the root) and reports it and its nested values to "visitor" (see "havSeriLiteVisitor")
+        // while decoding, without building values or copying strings. Returns "false" at the end of the input, on an error or if the
+        // visitor stopped. Pushed chunks have to hold the whole value.
+        template<typename V>
+        bool Parse(V& visitor)
+        {
+            HAVSERILITE_STATS(havSeriLiteStatsTimer timer(mStats.mDecodeTime));
+
+            const std::uint64_t offset = GetOffset();
+            const havSeriLiteValueView value = ReadValueView();
+
+            if (value.mType == havSeriLiteValueType::Close || (value.mType == havSeriLiteValueType::Null && IsNullValueAt(offset) == false))
+            {
+                return false;
+            }
+
+            return ParseValue(visitor, value);
+        }
+
+        bool ReadFile(const std::string& fileName, havSeriLiteLoadMode loadMode = havSeriLiteLoadMode::Buffered)
+        {
+            ResetSource();
+
+            if (loadMode == havSeriLiteLoadMode::MemoryMapped)
+            {
+                HAVSERILITE_STATS(havSeriLiteStatsTimer timer(mStats.mLoadTime));
+
+                if (mMappedFile.Open(fileName) == false)
+                {
+                    std::cerr << "Unable to map file: " << fileName << "!" << std::endl;
+                    return false;
+                }
+
+                return SetSourceImpl(mMappedFile.GetData(), mMappedFile.GetSize());
+            }
+
+            if (loadMode == havSeriLiteLoadMode::Streamed)
+            {
+                auto fileSource = std::make_unique<havSeriLiteFileSource>();
+
+                if (fileSource->Open(fileName) == false)
+                {
+                    std::cerr << "Unable to read file: " << fileName << "!" << std::endl;
+                    return false;
+                }
+
+                char magic[sizeof(havSeriLiteBlockFrame::Magic)] = {};
+                const bool isCompressed = fileSource->Read(magic, sizeof(magic)) == sizeof(magic) && std::memcmp(magic, havSeriLiteBlockFrame::Magic, sizeof(magic)) == 0;
+
+                if (fileSource->Rewind() == false)
+                {
+                    std::cerr << "Error: Failed to read file: " << fileName << "!" << std::endl;
+                    return false;
+                }
+
+                // Note: Compressed files are decompressed one block at a time, so memory use stays bounded.
+                if (isCompressed == true)
+                {
+                    return ReadStream(std::make_unique<havSeriLiteBlockSource>(std::move(fileSource)), mStreamOptions);
+                }
+
+                return ReadStream(std::move(fileSource), mStreamOptions);
+            }
+
+            HAVSERILITE_STATS(havSeriLiteStatsTimer timer(mStats.mLoadTime));
+
+#ifdef _WIN32
+            std::unique_ptr<std::FILE, decltype(&std::fclose)> fileStream(_wfopen(&ConvertStringToWString(fileName)[0], L"rb"), std::fclose);
+#else
+            std::unique_ptr<std::FILE, decltype(&std::fclose)> fileStream(std::fopen(fileName.c_str(), "rb"), std::fclose);
+#endif
+
+            if (fileStream == nullptr)
+            {
+                std::cerr << "Unable to read file: " << fileName << "!" << std::endl;
+                return false;
+            }
+
+            std::size_t fileSize = 0;
+
+            if (std::fseek(fileStream.get(), 0, SEEK_END) == 0)
+            {
+#ifdef _WIN32
+                long long position = _ftelli64(fileStream.get());
+#else
+                off_t position = ftello(fileStream.get());
+#endif
+                if (position > 0)
+                {
+                    fileSize = static_cast<std::size_t>(position);
+                }
+                std::fseek(fileStream.get(), 0, SEEK_SET);
+            }
+
+            std::size_t totalSize = 0;
+            AcquireBuffer();
+
+            if (fileSize > 0)
+            {
+                mBuffer.resize(fileSize);
+                totalSize = std::fread(mBuffer.data(), sizeof(char), mBuffer.size(), fileStream.get());
+            }
+            else
+            {
+                // Note: The size could not be determined up front (e.g. a pipe), so read in growing chunks instead.
+                mBuffer.resize(65536);
+
+                while (true)
+                {
+                    totalSize += std::fread(mBuffer.data() + totalSize, sizeof(char), mBuffer.size() - totalSize, fileStream.get());
+
+                    if (totalSize < mBuffer.size())
+                    {
+                        break;
+                    }
+
+                    mBuffer.resize(mBuffer.size() * 2);
+                }
+            }
+
+            if (std::ferror(fileStream.get()) != 0)
+            {
+                std::cerr << "Error: Failed to read file: " << fileName << "!" << std::endl;
+                mBuffer.clear();
+                return false;
+            }
+
+            mBuffer.resize(totalSize);
+
+            return SetSourceImpl(mBuffer.data(), mBuffer.size());
+        }
+
+        // Note: The data is borrowed, not copied, and must outlive the reader (or the next call to "ReadFile"/"ReadBuffer"). Compressed
+        // data (see "havSeriLiteBlockSink") is decompressed into a buffer owned by the reader instead.
+        bool ReadBuffer(const void* data, std::size_t size)
+        {
+            ResetSource();
+
+            if (data == nullptr && size > 0)
+            {
+                std::cerr << "Unable to read buffer: null data!" << std::endl;
+                return false;
+            }
+
+            return SetSource(static_cast<const char*>(data), size);
+        }
+
+#if HAVSERILITE_HAS_SPAN
+        inline bool ReadBuffer(std::span<const std::byte> data) { return ReadBuffer(data.data(), data.size()); }
+#endif
+
+        // Note: Same as "ReadBuffer". The buffers of the reader are kept, so a long-lived reader reset for every message decodes small
+        // messages without allocating, unless they contain dictionary strings or records, whose definitions are copied.
+        inline bool Reset(const void* data, std::size_t size) { return ReadBuffer(data, size); }
+
+#if HAVSERILITE_HAS_SPAN
+        inline bool Reset(std::span<const std::byte> data) { return ReadBuffer(data.data(), data.size()); }
+#endif
+
+        // Note: Reads the input through a window of "options.mWindowSize" bytes that is refilled from "source", so memory use stays
+        // constant regardless of the input size. Sized containers are skipped by seeking the source. "Find" and "At" are not supported.
+        bool ReadStream(std::unique_ptr<havSeriLiteSource> source, const havSeriLiteStreamOptions& options = {})
+        {
+            ResetSource();
+
+            if (source == nullptr)
+            {
+                std::cerr << "Unable to read stream: null source!" << std::endl;
+                return false;
+            }
+
+            mSource = std::move(source);
+
+            return StartStream(options);
+        }
+
+        // Note: Reads the input from chunks handed over with "PushChunk" (e.g. as they arrive from a socket) instead of a source.
+        // Values straddling the end of the pushed data are not consumed: the read fails with "NeedsMoreData" set and is repeated
+        // in full after the next chunk. Call "EndChunks" once the input is complete.
+        bool ReadChunks(const havSeriLiteStreamOptions& options = {})
+        {
+            ResetSource();
+
+            return StartStream(options);
+        }
+
+        bool PushChunk(const void* data, std::size_t size)
+        {
+            if (mStreaming == false || mSource != nullptr || mEndOfInput == true || (data == nullptr && size > 0))
+            {
+                return false;
+            }
+
+            const char* bytes = static_cast<const char*>(data);
+            const std::size_t skipSize = static_cast<std::size_t>(std::min<std::uint64_t>(size, mPendingSkip));
+            bytes += skipSize;
+            size -= skipSize;
+            mPendingSkip -= skipSize;
+
+            // Note: Everything in front of the cursor has been consumed, so the window only holds the unread bytes.
+            mTokenStart = mIndex;
+            Compact(mIndex);
+
+            if (mSize + size > mBuffer.size())
+            {
+                mBuffer.resize(std::max(static_cast<std::size_t>(mSize) + size, mBuffer.size() * 2));
+                mData = mBuffer.data();
+            }
+
+            if (size > 0)
+            {
+                std::memcpy(mBuffer.data() + mSize, bytes, size);
+                mSize += size;
+            }
+
+            HAVSERILITE_STATS(mStats.mNumOfBytes += size + skipSize);
+
+            return true;
+        }
+
+#if HAVSERILITE_HAS_SPAN
+        inline bool PushChunk(std::span<const std::byte> data) { return PushChunk(data.data(), data.size()); }
+#endif
+
+        inline void EndChunks() { mEndOfInput = true; }
+
+        // Note: "true" if the last read failed only because the pushed chunks ended within a value.
+        inline bool NeedsMoreData() const { return mStarved; }
+
+        // Note: Statistics collected since construction or "ResetStats", all zero unless "HAVSERILITE_ENABLE_STATS" is 1. Loading
+        // another input does not reset them.
+        inline const havSeriLiteStats& GetStats() const
+        {
+#if HAVSERILITE_ENABLE_STATS
+            return mStats;
+#else
+            static const havSeriLiteStats stats;
+            return stats;
+#endif
+        }
+
+        inline void ResetStats() { HAVSERILITE_STATS(mStats = havSeriLiteStats {}); }
+
+    private:
+        friend class havSeriLiteDocument;
+
+        void OutputJson(const havSeriLiteValue& value, std::int32_t depthLevel)
+        {
+            havSeriLiteOstreamSink sink(std::cout);
+            havSeriLiteJsonOptions options;
+            options.mPretty = true;
+
+            havSeriLiteJsonWriter json(sink, options, depthLevel);
+            WriteJson(json, value);
+            json.Flush();
+        }
+
+        template<typename V>
+        bool WriteJson(havSeriLiteJsonWriter& json, const V& value)
+        {
+            switch (value.mType)
+            {
+                case havSeriLiteValueType::Boolean: json.WriteBool(*TryReadBool(value)); break;
+                case havSeriLiteValueType::Int32:   json.WriteInt64(*TryReadInt32(value)); break;
+                case havSeriLiteValueType::UInt32:  json.WriteUInt64(*TryReadUInt32(value)); break;
+                case havSeriLiteValueType::Int64:   json.WriteInt64(*TryReadInt64(value)); break;
+                case havSeriLiteValueType::UInt64:  json.WriteUInt64(*TryReadUInt64(value)); break;
+                case havSeriLiteValueType::Double:  json.WriteDouble(*TryReadDouble(value)); break;
+                case havSeriLiteValueType::String:  json.WriteString(*TryReadStringView(value)); break;
+                case havSeriLiteValueType::Bytes:   json.WriteBase64(*TryReadBytes(value)); break;
+                case havSeriLiteValueType::Null:    json.WriteNull(); break;
+                case havSeriLiteValueType::TypedArray:
+                    {
+                        const havSeriLiteTypedArrayData typedArray = *TryReadTypedArray(value);
+                        const std::size_t elementSize = GetTypedArrayElementSize(typedArray.mElementType);
+
+                        if (IsInWindow(typedArray.mOffset, typedArray.mCount * elementSize) == false)
+                        {
+                            std::cerr << "Typed array is no longer available!" << std::endl;
+                            json.WriteNull();
+                            return false;
+                        }
+
+                        const char* elements = &mData[typedArray.mOffset - mBase];
+
+                        json.WriteArray();
+
+                        for (std::uint64_t i = 0; i < typedArray.mCount; ++i, elements += elementSize)
+                        {
+                            std::uint64_t bits = 0;
+                            std::memcpy(&bits, elements, elementSize);
+
+                            switch (typedArray.mElementType)
+                            {
+                                case havSeriLiteValueType::Int32:  json.WriteInt64(static_cast<std::int32_t>(bits)); break;
+                                case havSeriLiteValueType::UInt32: json.WriteUInt64(static_cast<std::uint32_t>(bits)); break;
+                                case havSeriLiteValueType::Int64:  json.WriteInt64(static_cast<std::int64_t>(bits)); break;
+                                case havSeriLiteValueType::UInt64: json.WriteUInt64(bits); break;
+                                default:
+                                    {
+                                        double number = 0.0;
+                                        std::memcpy(&number, elements, sizeof(double));
+                                        json.WriteDouble(number);
+                                    }
+                                    break;
+                            }
+                        }
+
+                        json.WriteClose();
+                    }
+                    break;
+                case havSeriLiteValueType::Record:
+                    {
+                        bool result = true;
+
+                        json.WriteObject();
+
+                        if (ReadRecordFields(value, [&](std::string_view name, const havSeriLiteValueView& field) {
+                            json.WriteString(name);
+                            result &= WriteJson(json, field);
+                        }) == false)
+                        {
+                            std::cerr << "Record is no longer available!" << std::endl;
+                            result = false;
+                        }
+
+                        json.WriteClose();
+
+                        return result;
+                    }
+                case havSeriLiteValueType::Array:
+                case havSeriLiteValueType::Object:
+                    {
+                        havSeriLiteValueView currentValue { nullptr, havSeriLiteValueType::Null };
+                        bool result = true;
+
+                        if (value.mType == havSeriLiteValueType::Array)
+                        {
+                            json.WriteArray();
+                        }
+                        else
+                        {
+                            json.WriteObject();
+                        }
+
+                        // Note: Keys and values are read one at a time, so a streamed key is written before reading its value moves the window.
+                        while (ArrayIterator(value.mDepthLevel, currentValue) == true)
+                        {
+                            result &= WriteJson(json, currentValue);
+                        }
+
+                        json.WriteClose();
+
+                        return result;
+                    }
+                default:
+                    std::cerr << "Unsupported value type!" << std::endl;
+                    return false;
+            }
+
+            return true;
+        }
+
+        template<typename V>
+        bool ParseValue(V& visitor, const havSeriLiteValueView& value)
+        {
+            switch (value.mType)
+            {
+                case havSeriLiteValueType::Null:       return visitor.OnNull() != havSeriLiteVisitAction::Stop;
+                case havSeriLiteValueType::Boolean:    return visitor.OnBool(*std::get_if<bool>(&value.mData)) != havSeriLiteVisitAction::Stop;
+                case havSeriLiteValueType::Int32:      return visitor.OnInt32(*std::get_if<std::int32_t>(&value.mData)) != havSeriLiteVisitAction::Stop;
+                case havSeriLiteValueType::UInt32:     return visitor.OnUInt32(*std::get_if<std::uint32_t>(&value.mData)) != havSeriLiteVisitAction::Stop;
+                case havSeriLiteValueType::Int64:      return visitor.OnInt64(*std::get_if<std::int64_t>(&value.mData)) != havSeriLiteVisitAction::Stop;
+                case havSeriLiteValueType::UInt64:     return visitor.OnUInt64(*std::get_if<std::uint64_t>(&value.mData)) != havSeriLiteVisitAction::Stop;
+                case havSeriLiteValueType::Double:     return visitor.OnDouble(*std::get_if<double>(&value.mData)) != havSeriLiteVisitAction::Stop;
+                case havSeriLiteValueType::String:     return visitor.OnString(*std::get_if<std::string_view>(&value.mData)) != havSeriLiteVisitAction::Stop;
+                case havSeriLiteValueType::Bytes:      return visitor.OnBytes(*std::get_if<std::string_view>(&value.mData)) != havSeriLiteVisitAction::Stop;
+                case havSeriLiteValueType::TypedArray: return ParseTypedArray(visitor, *std::get_if<havSeriLiteTypedArrayData>(&value.mData));
+                case havSeriLiteValueType::Record:     return ParseRecord(visitor, value);
+                case havSeriLiteValueType::Array:
+                case havSeriLiteValueType::Object:     return ParseContainer(visitor, value);
+                default:
+                    std::cerr << "Unsupported value type!" << std::endl;
+                    return false;
+            }
+        }
+
+        template<typename V>
+        bool ParseContainer(V& visitor, const havSeriLiteValueView& container)
+        {
+            const bool isObject = container.mType == havSeriLiteValueType::Object;
+            const havSeriLiteVisitAction action = isObject == true ? visitor.OnBeginObject() : visitor.OnBeginArray();
+
+            if (action != havSeriLiteVisitAction::Continue)
+            {
+                return action == havSeriLiteVisitAction::Skip && SkipContainer(container.mDepthLevel) == true;
+            }
+
+            // Note: Every other value of an object, starting with the first, is a key.
+            bool isKey = isObject;
+
+            while (true)
+            {
+                const std::uint64_t offset = GetOffset();
+                const havSeriLiteValueView value = ReadValueView();
+
+                if (value.mType == havSeriLiteValueType::Close)
+                {
+                    return visitor.OnEnd() != havSeriLiteVisitAction::Stop;
+                }
+
+                if (value.mType == havSeriLiteValueType::Null && IsNullValueAt(offset) == false)
+                {
+                    return false;
+                }
+
+                if (isKey == true && value.mType == havSeriLiteValueType::String)
+                {
+                    const havSeriLiteVisitAction keyAction = visitor.OnKey(*std::get_if<std::string_view>(&value.mData));
+
+                    if (keyAction == havSeriLiteVisitAction::Stop || (keyAction == havSeriLiteVisitAction::Skip && SkipValue() == false))
+                    {
+                        return false;
+                    }
+
+                    isKey = keyAction == havSeriLiteVisitAction::Skip;
+                    continue;
+                }
+
+                if (ParseValue(visitor, value) == false)
+                {
+                    return false;
+                }
+
+                isKey = isObject == true && isKey == false;
+            }
+        }
+
+        template<typename V>
+        bool ParseTypedArray(V& visitor, const havSeriLiteTypedArrayData& typedArray)
+        {
+            const havSeriLiteVisitAction action = visitor.OnBeginArray();
+
+            if (action != havSeriLiteVisitAction::Continue)
+            {
+                return action == havSeriLiteVisitAction::Skip;
+            }
+
+            const std::size_t elementSize = GetTypedArrayElementSize(typedArray.mElementType);
+
+            if (IsInWindow(typedArray.mOffset, typedArray.mCount * elementSize) == false)
+            {
+                std::cerr << "Typed array is no longer available!" << std::endl;
+                return false;
+            }
+
+            const char* elements = &mData[typedArray.mOffset - mBase];
+
+            for (std::uint64_t i = 0; i < typedArray.mCount; ++i, elements += elementSize)
+            {
+                havSeriLiteVisitAction elementAction = havSeriLiteVisitAction::Continue;
+
+                switch (typedArray.mElementType)
+                {
+                    case havSeriLiteValueType::Int32:  elementAction = visitor.OnInt32(LoadRecordField<std::int32_t>(elements)); break;
+                    case havSeriLiteValueType::UInt32: elementAction = visitor.OnUInt32(LoadRecordField<std::uint32_t>(elements)); break;
+                    case havSeriLiteValueType::Int64:  elementAction = visitor.OnInt64(LoadRecordField<std::int64_t>(elements)); break;
+                    case havSeriLiteValueType::UInt64: elementAction = visitor.OnUInt64(LoadRecordField<std::uint64_t>(elements)); break;
+                    default:                           elementAction = visitor.OnDouble(LoadRecordField<double>(elements)); break;
+                }
+
+                if (elementAction == havSeriLiteVisitAction::Stop)
+                {
+                    return false;
+                }
+            }
+
+            return visitor.OnEnd() != havSeriLiteVisitAction::Stop;
+        }
+
+        template<typename V>
+        bool ParseRecord(V& visitor, const havSeriLiteValueView& record)
+        {
+            const havSeriLiteVisitAction action = visitor.OnBeginObject();
+
+            if (action != havSeriLiteVisitAction::Continue)
+            {
+                return action == havSeriLiteVisitAction::Skip;
+            }
+
+            // Note: The fields were read together with the record, so stopping only suppresses the remaining callbacks.
+            bool stopped = false;
+
+            if (ReadRecordFields(record, [&](std::string_view name, const havSeriLiteValueView& field) {
+                if (stopped == true)
+                {
+                    return;
+                }
+
+                const havSeriLiteVisitAction keyAction = visitor.OnKey(name);
+
+                if (keyAction == havSeriLiteVisitAction::Continue)
+                {
+                    stopped = ParseValue(visitor, field) == false;
+                }
+                else
+                {
+                    stopped = keyAction == havSeriLiteVisitAction::Stop;
+                }
+            }) == false)
+            {
+                std::cerr << "Record is no longer available!" << std::endl;
+                return false;
+            }
+
+            return stopped == false && visitor.OnEnd() != havSeriLiteVisitAction::Stop;
+        }
+
+        havSeriLiteReader(const havSeriLiteReader& reader, const havSeriLiteElementRange& range) : mData(reader.mData), mSize(range.mEnd), mIndex(range.mOffset), mDepthLevel(0)
+        {
+            mContainerEnds.reserve(64);
+            mFormatFlags = reader.mFormatFlags;
+            mDataStart = range.mOffset;
+            mBorrowedDefinitions = &reader.GetDefinitions();
+        }
+
+        template<typename V>
+        bool IteratorImpl(const std::int32_t& depthLevel, V& value, V* key)
+        {
+            // Note: Skips any unconsumed values of nested containers without materializing them.
+            if (mDepthLevel > depthLevel)
+            {
+                SkipToDepth(depthLevel);
+            }
+
+            while (mDepthLevel != depthLevel && ReadToken() == true)
+            {
+            }
+
+            // Note: If pushed chunks end within the value, the cursor is rewound to the key, so the next call reads the pair again.
+            const std::int32_t savedDepthLevel = mDepthLevel;
+            mTokenStart = mIndex;
+
+            if (key != nullptr)
+            {
+                const std::uint64_t keyOffset = GetOffset();
+                *key = V { ReadNextValue() };
+                HAVSERILITE_STATS(CountStringCopy(*key));
+
+                if (key->mType == havSeriLiteValueType::Close || (key->mType == havSeriLiteValueType::Null && IsNullValueAt(keyOffset) == false))
+                {
+                    return false;
+                }
+            }
+
+            const std::uint64_t valueOffset = GetOffset();
+            const char* keyWindow = mData;
+            const std::uint64_t keyWindowBase = mBase;
+            const std::uint64_t keyWindowSize = mSize;
+            value = V { ReadNextValue() };
+            HAVSERILITE_STATS(CountStringCopy(value));
+
+            // Note: Reading the value may have moved the window of a streamed input, which a key viewed in the window has to follow.
+            if constexpr (std::is_same_v<V, havSeriLiteValueView>)
+            {
+                const std::string_view* keyData = key != nullptr ? std::get_if<std::string_view>(&key->mData) : nullptr;
+
+                if (keyData != nullptr && (mData != keyWindow || mBase != keyWindowBase) && keyData->data() >= keyWindow && keyData->data() < keyWindow + keyWindowSize)
+                {
+                    const std::uint64_t keyOffset = keyWindowBase + static_cast<std::uint64_t>(keyData->data() - keyWindow);
+                    key->mData = std::string_view { mData + (keyOffset - mBase), keyData->size() };
+                }
+            }
+
+            if (value.mType == havSeriLiteValueType::Null && IsNullValueAt(valueOffset) == false)
+            {
+                if (mStarved == true)
+                {
+                    mDepthLevel = savedDepthLevel;
+                }
+
+                return false;
+            }
+
+            if (key == nullptr)
+            {
+                return value.mType != havSeriLiteValueType::Close;
+            }
+
+            return true;
+        }
+
+        // Note: Reads a value without moving "mTokenStart", so a key and its value are kept in the window and rewound together.
+        havSeriLiteValueView ReadNextValue()
+        {
+            havSeriLiteValueView result = ReadNextValueImpl();
+            HAVSERILITE_STATS(CountValue(result));
+            return result;
+        }
+
+        havSeriLiteValueView ReadNextValueImpl()
+        {
+            havSeriLiteValueView result { nullptr, havSeriLiteValueType::Null };
+
+            mStarved = false;
+
+            if (mHeaderPending == true && ReadHeader() == false)
+            {
+                return result;
+            }
+
+            std::uint8_t tag = 0;
+            bool valid = ValidityCheck(&tag, sizeof(std::uint8_t));
+
+            if (tag >= static_cast<std::uint8_t>(havSeriLiteWireTag::SmallInteger))
+            {
+                return DecodeSmallInteger(tag);
+            }
+
+            if ((tag & 0xC0) == static_cast<std::uint8_t>(havSeriLiteWireTag::SmallStringReference))
+            {
+                return ReadStringReference(tag & 0x3F, result) == true ? result : FailRead();
+            }
+
+            switch (static_cast<havSeriLiteWireTag>(tag))
+            {
+                case havSeriLiteWireTag::False:
+                case havSeriLiteWireTag::True:
+                    result.mType = havSeriLiteValueType::Boolean;
+                    result.mData = tag == static_cast<std::uint8_t>(havSeriLiteWireTag::True);
+                    return result;
+
+                case havSeriLiteWireTag::EmptyString:
+                    result.mType = havSeriLiteValueType::String;
+                    result.mData = std::string_view {};
+                    return result;
+
+                case havSeriLiteWireTag::StringReference:
+                case havSeriLiteWireTag::StringDefinition:
+                    {
+                        std::uint64_t stringId = 0;
+                        valid &= ReadVarint(stringId) && stringId < havSeriLiteValueView::NoStringId;
+                        if (valid == true && tag == static_cast<std::uint8_t>(havSeriLiteWireTag::StringDefinition))
+                        {
+                            valid &= ReadStringDefinition(static_cast<std::uint32_t>(stringId));
+                        }
+                        valid = valid == true && ReadStringReference(static_cast<std::uint32_t>(stringId), result);
+                    }
+                    return valid == true ? result : FailRead();
+
+                case havSeriLiteWireTag::RecordReference:
+                case havSeriLiteWireTag::RecordDefinition:
+                    {
+                        std::uint64_t schemaId = 0;
+                        valid &= ReadVarint(schemaId) && schemaId < std::numeric_limits<std::uint32_t>::max();
+                        if (valid == true && tag == static_cast<std::uint8_t>(havSeriLiteWireTag::RecordDefinition))
+                        {
+                            valid &= ReadSchemaDefinition(static_cast<std::uint32_t>(schemaId));
+                        }
+                        valid = valid == true && ReadRecord(static_cast<std::uint32_t>(schemaId), result);
+                    }
+                    return valid == true ? result : FailRead();
+
+                default:
+                    break;
+            }
+
+            const std::uint8_t sizedFlag = static_cast<std::uint8_t>(havSeriLiteWireTag::SizedFlag);
+            const bool sized = (tag & sizedFlag) != 0;
+            result.mType = static_cast<havSeriLiteValueType>(tag & ~sizedFlag);
+
+            if (sized == true && result.mType != havSeriLiteValueType::Array && result.mType != havSeriLiteValueType::Object)
+            {
+                result.mType = havSeriLiteValueType::Null;
+            }
+
+            switch (result.mType)
+            {
+                case havSeriLiteValueType::Null:
+                    HAVSERILITE_STATS(if (valid == true) { CountValueType(havSeriLiteValueType::Null); })
+                    break;
+
+                case havSeriLiteValueType::Close:
+                    --mDepthLevel;
+                    break;
+
+                case havSeriLiteValueType::Boolean:
+                    result.mData = false;
+                    valid &= ValidityCheck(&std::get<bool>(result.mData), sizeof(bool));
+                    break;
+
+                case havSeriLiteValueType::Int32:
+                    result.mData = std::int32_t { 0 };
+                    valid &= ReadInteger(std::get<std::int32_t>(result.mData));
+                    break;
+
+                case havSeriLiteValueType::UInt32:
+                    result.mData = std::uint32_t { 0 };
+                    valid &= ReadInteger(std::get<std::uint32_t>(result.mData));
+                    break;
+
+                case havSeriLiteValueType::Int64:
+                    result.mData = std::int64_t { 0 };
+                    valid &= ReadInteger(std::get<std::int64_t>(result.mData));
+                    break;
+
+                case havSeriLiteValueType::UInt64:
+                    result.mData = std::uint64_t { 0 };
+                    valid &= ReadInteger(std::get<std::uint64_t>(result.mData));
+                    break;
+
+                case havSeriLiteValueType::Double:
+                    result.mData = double { 0.0 };
+                    valid &= ValidityCheck(&std::get<double>(result.mData), sizeof(double));
+                    break;
+
+                case havSeriLiteValueType::String:
+                case havSeriLiteValueType::Bytes:
+                    {
+                        std::uint64_t stringSize = 0;
+                        valid &= ReadLength(stringSize);
+                        // Note: Empty strings are valid, but "ValidityCheck" rejects zero-sized reads.
+                        valid &= stringSize == 0 || ValidityCheck(nullptr, stringSize);
+                        if (valid == true)
+                        {
+                            result.mData = std::string_view { &mData[mIndex - stringSize], static_cast<std::size_t>(stringSize) };
+                        }
+                    }
+                    break;
+
+                case havSeriLiteValueType::Array:
+                case havSeriLiteValueType::Object:
+                    {
+                        havSeriLiteContainerData container;
+                        bool definesStrings = false;
+                        if (sized == true)
+                        {
+                            valid &= ValidityCheck(&container.mByteSize, sizeof(std::uint64_t));
+                            valid &= ValidityCheck(&container.mCount, sizeof(std::uint64_t));
+                            definesStrings = (container.mCount & havSeriLiteContainerData::DefinesStringsFlag) != 0;
+                            container.mCount &= ~havSeriLiteContainerData::DefinesStringsFlag;
+                        }
+                        container.mOffset = GetOffset();
+                        // Note: A streamed input is not known in full, so sizes are only checked when the container is skipped.
+                        valid &= mStreaming == true || container.mByteSize <= mSize - mIndex;
+                        if (valid == true)
+                        {
+                            result.mDepthLevel = ++mDepthLevel;
+                            SetContainerEnd(mDepthLevel, container.mByteSize > 0 && definesStrings == false ? container.mOffset + container.mByteSize : 0);
+                        }
+                        result.mData = container;
+                    }
+                    break;
+
+                case havSeriLiteValueType::TypedArray:
+                    {
+                        havSeriLiteTypedArrayData typedArray;
+                        std::uint8_t padding = 0;
+                        valid &= ValidityCheck(&typedArray.mElementType, sizeof(std::uint8_t));
+                        valid &= ReadInteger(typedArray.mCount);
+                        valid &= ValidityCheck(&padding, sizeof(std::uint8_t));
+                        valid &= padding == 0 || ValidityCheck(nullptr, padding);
+                        const std::size_t elementSize = GetTypedArrayElementSize(typedArray.mElementType);
+                        valid &= elementSize > 0 && typedArray.mCount <= std::numeric_limits<std::uint64_t>::max() / elementSize;
+                        typedArray.mOffset = GetOffset();
+                        if (valid == true && typedArray.mCount > 0)
+                        {
+                            valid &= ValidityCheck(nullptr, typedArray.mCount * elementSize);
+                        }
+                        result.mData = typedArray;
+                    }
+                    break;
+
+                default:
+                    valid &= false;
+                    break;
+            }
+
+            if (valid == false)
+            {
+                return FailRead();
+            }
+
+            return result;
+        }
+
+#if HAVSERILITE_ENABLE_STATS
+        inline void CountValueType(havSeriLiteValueType type)
+        {
+            ++mStats.mNumOfValues[static_cast<std::size_t>(type)];
+        }
+
+        // Note: "Null" values are counted while decoding, as failed reads also return "Null".
+        inline void CountValue(const havSeriLiteValueView& value)
+        {
+            if (value.mType == havSeriLiteValueType::Null)
+            {
+                return;
+            }
+
+            CountValueType(value.mType);
+
+            if (value.mType == havSeriLiteValueType::String || value.mType == havSeriLiteValueType::Bytes)
+            {
+                mStats.mNumOfStringBytes += std::get<std::string_view>(value.mData).size();
+            }
+
+            mStats.mMaxDepthLevel = std::max(mStats.mMaxDepthLevel, mDepthLevel);
+        }
+
+        template<typename V>
+        inline void CountStringCopy(const V& value)
+        {
+            if constexpr (std::is_same_v<V, havSeriLiteValue>)
+            {
+                mStats.mNumOfStringAllocations += value.mType == havSeriLiteValueType::String || value.mType == havSeriLiteValueType::Bytes ? 1 : 0;
+            }
+        }
+#endif
+
+        // Note: Depth level and container ends are only updated after a successful read, so rewinding the cursor is enough to resume.
+        havSeriLiteValueView FailRead()
+        {
+            if (mStarved == true)
+            {
+                mIndex = mTokenStart;
+            }
+            else
+            {
+                HAVSERILITE_STATS(++mStats.mNumOfErrors);
+                HAVSERILITE_STATS(mStats.mLastErrorOffset = mBase + mTokenStart);
+            }
+
+            return havSeriLiteValueView { nullptr, havSeriLiteValueType::Null };
+        }
+
+        // Note: Dictionary strings are copied into "mStrings", so views of them stay valid until the input is replaced, even when streaming.
+        bool ReadStringDefinition(std::uint32_t stringId)
+        {
+            std::uint64_t stringSize = 0;
+
+            if (ReadLength(stringSize) == false || (stringSize > 0 && ValidityCheck(nullptr, stringSize) == false))
+            {
+                return false;
+            }
+
+            // Note: Definitions are read again after rewinding or seeking back, so known ids are kept as they are.
+            if (stringId < GetDefinitions().mStrings.size())
+            {
+                return true;
+            }
+
+            if (stringId != GetDefinitions().mStrings.size())
+            {
+                return false;
+            }
+
+            OwnDefinitions();
+            mStrings.emplace_back(&mData[mIndex - stringSize], static_cast<std::size_t>(stringSize));
+            mStringIds.emplace(mStrings.back(), stringId);
+            HAVSERILITE_STATS(++mStats.mNumOfStringAllocations);
+
+            return true;
+        }
+
+        bool ReadStringReference(std::uint32_t stringId, havSeriLiteValueView& result)
+        {
+            const std::deque<std::string>& strings = GetDefinitions().mStrings;
+
+            if (stringId >= strings.size())
+            {
+                return false;
+            }
+
+            result.mType = havSeriLiteValueType::String;
+            result.mData = std::string_view { strings[stringId] };
+            result.mStringId = stringId;
+
+            return true;
+        }
+
+        struct havSeriLiteRecordSchema
+        {
+            std::vector<std::string> mNames;
+            std::vector<havSeriLiteValueType> mTypes;
+            // Note: Size of the field values, if the schema has no strings.
+            std::uint64_t mFixedSize = 0;
+            bool mHasStrings = false;
+        };
+
+        // Note: Fields last compared with a schema by "TryReadRecordPayload" and whether they matched. The checks are kept per reader,
+        // apart from the schemas, which range readers share.
+        struct havSeriLiteSchemaCheck
+        {
+            const havSeriLiteSchemaField* mCheckedFields = nullptr;
+            bool mMatchesFields = false;
+        };
+
+        static constexpr std::uint64_t MaxNumOfRecordFields = 65536;
+
+        bool ReadSchemaDefinition(std::uint32_t schemaId)
+        {
+            std::uint64_t numOfFields = 0;
+
+            if (ReadVarint(numOfFields) == false || numOfFields > MaxNumOfRecordFields)
+            {
+                return false;
+            }
+
+            havSeriLiteRecordSchema schema;
+            schema.mNames.reserve(static_cast<std::size_t>(numOfFields));
+            schema.mTypes.reserve(static_cast<std::size_t>(numOfFields));
+
+            for (std::uint64_t i = 0; i < numOfFields; ++i)
+            {
+                havSeriLiteValueType type = havSeriLiteValueType::Null;
+                std::uint64_t nameSize = 0;
+
+                if (ValidityCheck(&type, sizeof(std::uint8_t)) == false || (GetRecordFieldSize(type) == 0 && type != havSeriLiteValueType::String) ||
+                    ReadVarint(nameSize) == false || (nameSize > 0 && ValidityCheck(nullptr, nameSize) == false))
+                {
+                    return false;
+                }
+
+                // Note: Names are copied right away, as reading the next one may refill a streamed window.
+                schema.mNames.emplace_back(&mData[mIndex - nameSize], static_cast<std::size_t>(nameSize));
+                schema.mTypes.push_back(type);
+                schema.mFixedSize += GetRecordFieldSize(type);
+                schema.mHasStrings |= type == havSeriLiteValueType::String;
+            }
+
+            // Note: A known id is a definition read again (see "ReadStringDefinition"). The stored schema is kept rather than replaced, as
+            // record fields in the index refer to its names and its layout check in "TryReadRecordPayload" stays valid.
+            if (schemaId < GetDefinitions().mSchemas.size())
+            {
+                return true;
+            }
+
+            if (schemaId != GetDefinitions().mSchemas.size())
+            {
+                return false;
+            }
+
+            OwnDefinitions();
+            HAVSERILITE_STATS(mStats.mNumOfStringAllocations += schema.mNames.size());
+            mSchemas.push_back(std::move(schema));
+
+            return true;
+        }
+
+        // Note: Checks that the field values of a record are complete, in one step for schemas without strings.
+        bool ReadRecord(std::uint32_t schemaId, havSeriLiteValueView& result)
+        {
+            if (schemaId >= GetDefinitions().mSchemas.size())
+            {
+                return false;
+            }
+
+            const havSeriLiteRecordSchema& schema = GetDefinitions().mSchemas[schemaId];
+            havSeriLiteRecordData record;
+            record.mSchemaId = schemaId;
+            record.mOffset = GetOffset();
+
+            if (schema.mHasStrings == false)
+            {
+                if (schema.mFixedSize > 0 && ValidityCheck(nullptr, schema.mFixedSize) == false)
+                {
+                    return false;
+                }
+            }
+            else
+            {
+                for (havSeriLiteValueType type : schema.mTypes)
+                {
+                    std::uint64_t size = GetRecordFieldSize(type);
+
+                    if ((type == havSeriLiteValueType::String && ReadVarint(size) == false) || (size > 0 && ValidityCheck(nullptr, size) == false))
+                    {
+                        return false;
+                    }
+                }
+            }
+
+            record.mByteSize = GetOffset() - record.mOffset;
+            result.mType = havSeriLiteValueType::Record;
+            result.mData = record;
+
+            return true;
+        }
+
+        template<typename V>
+        const char* GetRecordPayload(const V& value, const havSeriLiteRecordSchema*& schema)
+        {
+            const havSeriLiteRecordData* record = value.mType == havSeriLiteValueType::Record ? std::get_if<havSeriLiteRecordData>(&value.mData) : nullptr;
+            const std::deque<havSeriLiteRecordSchema>& schemas = GetDefinitions().mSchemas;
+
+            if (record == nullptr || record->mSchemaId >= schemas.size() || IsInWindow(record->mOffset, record->mByteSize) == false)
+            {
+                return nullptr;
+            }
+
+            schema = &schemas[record->mSchemaId];
+
+            return &mData[record->mOffset - mBase];
+        }
+
+        // Note: Decodes the record field of type "type" at "data" like a value read with "ReadValueView", and moves "data" past it.
+        static havSeriLiteValueView DecodeRecordField(const char*& data, havSeriLiteValueType type)
+        {
+            const char* field = data;
+            data += GetRecordFieldSize(type);
+
+            switch (type)
+            {
+                case havSeriLiteValueType::Boolean: return havSeriLiteValueView(type, *field != 0);
+                case havSeriLiteValueType::Int32:   return havSeriLiteValueView(type, LoadRecordField<std::int32_t>(field));
+                case havSeriLiteValueType::UInt32:  return havSeriLiteValueView(type, LoadRecordField<std::uint32_t>(field));
+                case havSeriLiteValueType::Int64:   return havSeriLiteValueView(type, LoadRecordField<std::int64_t>(field));
+                case havSeriLiteValueType::UInt64:  return havSeriLiteValueView(type, LoadRecordField<std::uint64_t>(field));
+                case havSeriLiteValueType::Double:  return havSeriLiteValueView(type, LoadRecordField<double>(field));
+                default:
+                    {
+                        const std::size_t stringSize = static_cast<std::size_t>(DecodeVarint(data));
+                        const havSeriLiteValueView result(type, std::string_view { data, stringSize });
+                        data += stringSize;
+                        return result;
+                    }
+            }
+        }
+
+        template<typename T>
+        static inline T LoadRecordField(const char* data)
+        {
+            T value;
+            std::memcpy(&value, data, sizeof(T));
+            return value;
+        }
+
+        static constexpr std::uint32_t NoIndexNode = static_cast<std::uint32_t>(-1);
+
+        struct havSeriLiteIndexNode
+        {
+            // Note: Offsets of the container's tag and first element, and of the byte following its closing tag (zero if unclosed).
+            std::uint64_t mTagOffset;
+            std::uint64_t mOffset;
+            std::uint64_t mEnd;
+            std::uint32_t mParent;
+            std::int32_t mDepthLevel;
+            std::uint32_t mFirstEntry;
+            std::uint32_t mNumOfEntries;
+            bool mIsObject;
+            // Note: Records are indexed like objects whose members are the fields, with "mOffset" at the field values and "mEnd" behind
+            // them. They add no depth level, so "mDepthLevel" is the one of the enclosing container.
+            bool mIsRecord;
+        };
+
+        struct havSeriLiteIndexEntry
+        {
+            // Note: Key of an object member or record field (empty for array elements and non-string keys) and offset of the value's
+            // tag, or of the field value for record fields.
+            std::string_view mKey;
+            std::uint64_t mValueOffset;
+            // Note: Index node of the value if it is a container or record, "NoIndexNode" otherwise.
+            std::uint32_t mNode;
+            // Note: Type of a record field, whose value has no tag, "Null" for all other values.
+            havSeriLiteValueType mFieldType = havSeriLiteValueType::Null;
+        };
+
+        // Note: Scans the whole input once and records every container with the offsets (and keys) of its elements.
+        // Node 0 is a virtual root holding the top-level values.
+        bool BuildIndex()
+        {
+            if (mIndexBuilt == true)
+            {
+                return mIndexNodes.empty() == false;
+            }
+
+            mIndexBuilt = true;
+
+            // Note: A streamed input is never held in memory as a whole, so it cannot be indexed.
+            if (mStreaming == true)
+            {
+                return false;
+            }
+
+            HAVSERILITE_STATS(havSeriLiteStatsTimer timer(mStats.mDecodeTime));
+
+            struct havSeriLiteIndexFrame
+            {
+                std::uint32_t mNode;
+                std::size_t mPendingStart;
+                bool mExpectKey;
+                std::string_view mKey;
+            };
+
+            const std::uint64_t savedIndex = mIndex;
+            const std::int32_t savedDepthLevel = mDepthLevel;
+            const std::vector<std::uint64_t> savedContainerEnds = mContainerEnds;
+
+            mIndex = mDataStart;
+            mDepthLevel = 0;
+
+            std::vector<havSeriLiteIndexFrame> frames;
+            std::vector<havSeriLiteIndexEntry> pending;
+
+            mIndexNodes.push_back(havSeriLiteIndexNode { 0, 0, mSize, NoIndexNode, 0, 0, 0, false, false });
+            frames.push_back(havSeriLiteIndexFrame { 0, 0, false, std::string_view {} });
+
+            auto FinishNode = [&](havSeriLiteIndexFrame& frame) {
+                havSeriLiteIndexNode& node = mIndexNodes[frame.mNode];
+                node.mFirstEntry = static_cast<std::uint32_t>(mIndexEntries.size());
+                node.mNumOfEntries = static_cast<std::uint32_t>(pending.size() - frame.mPendingStart);
+                mIndexEntries.insert(mIndexEntries.end(), pending.begin() + frame.mPendingStart, pending.end());
+                pending.resize(frame.mPendingStart);
+            };
+
+            while (true)
+            {
+                const std::uint64_t tagOffset = mIndex;
+                havSeriLiteValueView value = ReadValueView();
+
+                if (value.mType == havSeriLiteValueType::Null && IsNullValueAt(tagOffset) == false)
+                {
+                    break;
+                }
+
+                havSeriLiteIndexFrame& frame = frames.back();
+
+                if (value.mType == havSeriLiteValueType::Close)
+                {
+                    if (frames.size() == 1)
+                    {
+                        break;
+                    }
+
+                    mIndexNodes[frame.mNode].mEnd = mIndex;
+                    FinishNode(frame);
+                    frames.pop_back();
+                    continue;
+                }
+
+                if (frame.mExpectKey == true)
+                {
+                    frame.mKey = value.mType == havSeriLiteValueType::String ? std::get<std::string_view>(value.mData) : std::string_view {};
+                    frame.mExpectKey = false;
+                    continue;
+                }
+
+                havSeriLiteIndexEntry entry { frame.mKey, tagOffset, NoIndexNode };
+                frame.mKey = std::string_view {};
+                frame.mExpectKey = mIndexNodes[frame.mNode].mIsObject;
+
+                if (value.mType == havSeriLiteValueType::Array || value.mType == havSeriLiteValueType::Object)
+                {
+                    entry.mNode = static_cast<std::uint32_t>(mIndexNodes.size());
+                    const std::uint64_t offset = std::get<havSeriLiteContainerData>(value.mData).mOffset;
+                    const bool isObject = value.mType == havSeriLiteValueType::Object;
+                    mIndexNodes.push_back(havSeriLiteIndexNode { tagOffset, offset, 0, frame.mNode, value.mDepthLevel, 0, 0, isObject, false });
+                    pending.push_back(entry);
+                    frames.push_back(havSeriLiteIndexFrame { entry.mNode, pending.size(), isObject, std::string_view {} });
+                }
+                else if (value.mType == havSeriLiteValueType::Record)
+                {
+                    entry.mNode = IndexRecord(value, tagOffset, frame.mNode);
+                    pending.push_back(entry);
+                }
+                else
+                {
+                    pending.push_back(entry);
+                }
+            }
+
+            // Note: Containers left open by truncated input keep an unknown end, but their elements remain reachable.
+            while (frames.empty() == false)
+            {
+                FinishNode(frames.back());
+                frames.pop_back();
+            }
+
+            mIndex = savedIndex;
+            mDepthLevel = savedDepthLevel;
+            mContainerEnds = savedContainerEnds;
+
+            return true;
+        }
+
+        // Note: Adds the node of a record just read, whose entries are its fields. Their entries are stored right away, as a record
+        // holds no other values.
+        std::uint32_t IndexRecord(const havSeriLiteValueView& record, std::uint64_t tagOffset, std::uint32_t parent)
+        {
+            const havSeriLiteRecordSchema* schema = nullptr;
+            const char* payload = GetRecordPayload(record, schema);
+            const std::uint32_t node = static_cast<std::uint32_t>(mIndexNodes.size());
+            const std::uint64_t offset = std::get<havSeriLiteRecordData>(record.mData).mOffset;
+
+            mIndexNodes.push_back(havSeriLiteIndexNode { tagOffset, offset, mIndex, parent, mIndexNodes[parent].mDepthLevel, static_cast<std::uint32_t>(mIndexEntries.size()), 0, true, true });
+
+            if (payload == nullptr)
+            {
+                return node;
+            }
+
+            const char* data = payload;
+
+            for (std::size_t i = 0; i < schema->mTypes.size(); ++i)
+            {
+                const std::uint64_t fieldOffset = offset + static_cast<std::uint64_t>(data - payload);
+                DecodeRecordField(data, schema->mTypes[i]);
+                mIndexEntries.push_back(havSeriLiteIndexEntry { std::string_view { schema->mNames[i] }, fieldOffset, NoIndexNode, schema->mTypes[i] });
+            }
+
+            mIndexNodes[node].mNumOfEntries = static_cast<std::uint32_t>(schema->mTypes.size());
+
+            return node;
+        }
+
+        template<typename V>
+        std::uint32_t FindIndexNode(const V& container)
+        {
+            std::optional<std::uint64_t> containerOffset;
+
+            if (auto containerData = TryReadContainer(container); containerData.has_value() == true)
+            {
+                containerOffset = containerData->mOffset;
+            }
+            else if (auto record = TryReadRecord(container); record.has_value() == true)
+            {
+                containerOffset = record->mOffset;
+            }
+
+            if (containerOffset.has_value() == false || BuildIndex() == false)
+            {
+                return NoIndexNode;
+            }
+
+            // Note: Nodes are created in input order, so they are sorted by offset.
+            auto it = std::lower_bound(mIndexNodes.begin() + 1, mIndexNodes.end(), *containerOffset, [](const havSeriLiteIndexNode& node, std::uint64_t offset) {
+                return node.mOffset < offset;
+            });
+
+            if (it == mIndexNodes.end() || it->mOffset != *containerOffset)
+            {
+                return NoIndexNode;
+            }
+
+            return static_cast<std::uint32_t>(it - mIndexNodes.begin());
+        }
+
+        havSeriLiteValueView FindFromEntry(std::uint32_t parent, const havSeriLiteIndexEntry& entry, std::string_view path)
+        {
+            while (path.empty() == false && path.front() == '/')
+            {
+                path.remove_prefix(1);
+            }
+
+            if (path.empty() == true)
+            {
+                return SeekIndexEntry(parent, entry);
+            }
+
+            if (entry.mNode == NoIndexNode)
+            {
+                return havSeriLiteValueView { nullptr, havSeriLiteValueType::Null };
+            }
+
+            return FindFromNode(entry.mNode, path);
+        }
+
+        havSeriLiteValueView FindFromNode(std::uint32_t node, std::string_view path)
+        {
+            const std::size_t separator = path.find('/');
+            const std::string_view segment = path.substr(0, separator);
+            const std::string_view rest = separator == std::string_view::npos ? std::string_view {} : path.substr(separator);
+
+            const havSeriLiteIndexNode& indexNode = mIndexNodes[node];
+            const havSeriLiteIndexEntry* entries = mIndexEntries.data() + indexNode.mFirstEntry;
+
+            if (indexNode.mIsObject == true)
+            {
+                for (std::uint32_t i = 0; i < indexNode.mNumOfEntries; ++i)
+                {
+                    if (entries[i].mKey == segment)
+                    {
+                        return FindFromEntry(node, entries[i], rest);
+                    }
+                }
+            }
+            else
+            {
+                std::uint64_t elementIndex = 0;
+                auto [end, error] = std::from_chars(segment.data(), segment.data() + segment.size(), elementIndex);
+
+                if (error == std::errc() && end == segment.data() + segment.size() && elementIndex < indexNode.mNumOfEntries)
+                {
+                    return FindFromEntry(node, entries[elementIndex], rest);
+                }
+            }
+
+            return havSeriLiteValueView { nullptr, havSeriLiteValueType::Null };
+        }
+
+        inline havSeriLiteValueView SeekIndexEntry(std::uint32_t parent, const havSeriLiteIndexEntry& entry)
+        {
+            if (entry.mFieldType != havSeriLiteValueType::Null)
+            {
+                return SeekRecordField(parent, entry);
+            }
+
+            return SeekIndexEntry(parent, entry.mValueOffset, entry.mNode);
+        }
+
+        // Note: Moves the cursor to a value inside the container "parent" and reads it, restoring the depth level and container ends
+        // sequential reading would have produced.
+        havSeriLiteValueView SeekIndexEntry(std::uint32_t parent, std::uint64_t valueOffset, std::uint32_t node)
+        {
+            mIndex = valueOffset;
+            RestoreContainerEnds(parent);
+
+            havSeriLiteValueView result = ReadValueView();
+
+            if (node != NoIndexNode && mIndexNodes[node].mIsRecord == false)
+            {
+                SetContainerEnd(mIndexNodes[node].mDepthLevel, mIndexNodes[node].mEnd);
+            }
+
+            return result;
+        }
+
+        // Note: Decodes a field of the record "record" and moves the cursor behind the record, where reading the record would have left it.
+        havSeriLiteValueView SeekRecordField(std::uint32_t record, const havSeriLiteIndexEntry& entry)
+        {
+            mIndex = mIndexNodes[record].mEnd;
+            RestoreContainerEnds(mIndexNodes[record].mParent);
+
+            const char* data = &mData[entry.mValueOffset];
+            havSeriLiteValueView result = DecodeRecordField(data, entry.mFieldType);
+            result.mDepthLevel = mDepthLevel;
+
+            return result;
+        }
+
+        void RestoreContainerEnds(std::uint32_t parent)
+        {
+            mDepthLevel = parent == NoIndexNode ? 0 : mIndexNodes[parent].mDepthLevel;
+
+            for (std::uint32_t ancestor = parent; ancestor != NoIndexNode && ancestor != 0; ancestor = mIndexNodes[ancestor].mParent)
+            {
+                SetContainerEnd(mIndexNodes[ancestor].mDepthLevel, mIndexNodes[ancestor].mEnd);
+            }
+        }
+
+        inline bool ReadVarint(std::uint64_t& value)
+        {
+            value = 0;
+
+            for (std::uint32_t shift = 0; shift < 64; shift += 7)
+            {
+                if (mIndex >= mSize && Refill(1) == false)
+                {
+                    return false;
+                }
+
+                const std::uint8_t byte = static_cast<std::uint8_t>(mData[mIndex++]);
+                value |= static_cast<std::uint64_t>(byte & 0x7F) << shift;
+
+                if ((byte & 0x80) == 0)
+                {
+                    return true;
+                }
+            }
+
+            return false;
+        }
+
+        template<typename T>
+        inline bool ReadInteger(T& value)
+        {
+            if ((mFormatFlags & static_cast<std::uint8_t>(havSeriLiteFormatFlag::Compact)) == 0)
+            {
+                return ValidityCheck(&value, sizeof(T));
+            }
+
+            std::uint64_t encoded = 0;
+
+            if (ReadVarint(encoded) == false)
+            {
+                return false;
+            }
+
+            if constexpr (std::is_signed_v<T>)
+            {
+                const std::int64_t decoded = ZigZagDecode(encoded);
+
+                if (decoded < std::numeric_limits<T>::min() || decoded > std::numeric_limits<T>::max())
+                {
+                    return false;
+                }
+
+                value = static_cast<T>(decoded);
+            }
+            else
+            {
+                if (encoded > std::numeric_limits<T>::max())
+                {
+                    return false;
+                }
+
+                value = static_cast<T>(encoded);
+            }
+
+            return true;
+        }
+
+        inline bool ReadLength(std::uint64_t& length)
+        {
+            if ((mFormatFlags & static_cast<std::uint8_t>(havSeriLiteFormatFlag::Compact)) != 0)
+            {
+                return ReadVarint(length);
+            }
+
+            std::uint32_t fixedLength = 0;
+            bool valid = ValidityCheck(&fixedLength, sizeof(std::uint32_t));
+            length = fixedLength;
+
+            return valid;
+        }
+
+        havSeriLiteValueView DecodeSmallInteger(std::uint8_t tag)
+        {
+            const std::uint64_t value = tag & 0x0F;
+            havSeriLiteValueView result { nullptr, static_cast<havSeriLiteValueType>(static_cast<std::uint8_t>(havSeriLiteValueType::Int32) + ((tag >> 4) & 0x03)) };
+
+            switch (result.mType)
+            {
+                case havSeriLiteValueType::Int32:  result.mData = static_cast<std::int32_t>(ZigZagDecode(value)); break;
+                case havSeriLiteValueType::UInt32: result.mData = static_cast<std::uint32_t>(value); break;
+                case havSeriLiteValueType::Int64:  result.mData = ZigZagDecode(value); break;
+                default:                           result.mData = value; break;
+            }
+
+            return result;
+        }
+
+        // Note: Leaves containers until the reader is back at "depthLevel", jumping over sized containers in constant time.
+        bool SkipToDepth(std::int32_t depthLevel)
+        {
+            HAVSERILITE_STATS(mStats.mNumOfSkippedContainers += static_cast<std::uint64_t>(std::max(mDepthLevel - depthLevel, 0)));
+
+            while (mDepthLevel > depthLevel)
+            {
+                const std::uint64_t containerEnd = GetContainerEnd(mDepthLevel);
+
+                if (containerEnd != 0)
+                {
+                    if (SeekTo(containerEnd) == false)
+                    {
+                        return false;
+                    }
+
+                    --mDepthLevel;
+                }
+                else if (ReadToken() == false)
+                {
+                    return false;
+                }
+            }
+
+            return true;
+        }
+
+        // Note: Reads and discards one value, returning "false" if the input is exhausted or malformed.
+        inline bool ReadToken()
+        {
+            const std::uint64_t offset = GetOffset();
+            return ReadValueView().mType != havSeriLiteValueType::Null || IsNullValueAt(offset) == true;
+        }
+
+        // Note: Tells a "Null" value in the input apart from a failed read, which also yields "Null".
+        inline bool IsNullValueAt(std::uint64_t offset) const
+        {
+            return IsInWindow(offset, 1) == true && static_cast<havSeriLiteValueType>(mData[offset - mBase]) == havSeriLiteValueType::Null;
+        }
+
+        // Note: Input offset of the cursor. Offsets stored in values and container ends are input offsets, not window positions.
+        inline std::uint64_t GetOffset() const
+        {
+            return mBase + mIndex;
+        }
+
+        inline bool IsInWindow(std::uint64_t offset, std::uint64_t size) const
+        {
+            return offset >= mBase && offset - mBase <= mSize && size <= mSize - (offset - mBase);
+        }
+
+        // Note: Moves the cursor forward to an input offset, which may lie beyond the window of a streamed input.
+        bool SeekTo(std::uint64_t offset)
+        {
+            if (offset <= mBase + mSize)
+            {
+                mIndex = offset - mBase;
+                return true;
+            }
+
+            if (mStreaming == false)
+            {
+                return false;
+            }
+
+            const std::uint64_t skipSize = offset - (mBase + mSize);
+            mBase = offset;
+            mSize = 0;
+            mIndex = 0;
+            mTokenStart = 0;
+
+            if (mSource == nullptr)
+            {
+                // Note: The skipped bytes have not been pushed yet, so they are dropped as they arrive.
+                mPendingSkip += skipSize;
+                return true;
+            }
+
+            if (mSource->Skip(skipSize) == false)
+            {
+                mEndOfInput = true;
+                return false;
+            }
+
+            return true;
+        }
+
+        // Note: Drops the bytes in front of "offset" from the window.
+        void Compact(std::uint64_t offset)
+        {
+            if (offset == 0)
+            {
+                return;
+            }
+
+            std::memmove(mBuffer.data(), mBuffer.data() + offset, static_cast<std::size_t>(mSize - offset));
+            mBase += offset;
+            mSize -= offset;
+            mIndex -= offset;
+            mTokenStart = mTokenStart > offset ? mTokenStart - offset : 0;
+        }
+
+        // Note: Makes "size" bytes after the cursor available in a streamed input, keeping the value being read in the window.
+        // The window only grows beyond its configured size to hold a single larger value.
+        bool Refill(std::uint64_t size)
+        {
+            if (mStreaming == false)
+            {
+                return false;
+            }
+
+            HAVSERILITE_STATS(havSeriLiteStatsTimer timer(mStats.mLoadTime));
+            HAVSERILITE_STATS(++mStats.mNumOfRefills);
+
+            Compact(mTokenStart);
+
+            const std::uint64_t requiredSize = mIndex + size;
+
+            if (requiredSize > mBuffer.size())
+            {
+                if (size > mStreamOptions.mMaxValueSize || requiredSize > mStreamOptions.mMaxValueSize)
+                {
+                    std::cerr << "Error: Value exceeds the maximum supported size of " << mStreamOptions.mMaxValueSize << " bytes!" << std::endl;
+                    return false;
+                }
+
+                mBuffer.resize(static_cast<std::size_t>(requiredSize));
+                mData = mBuffer.data();
+            }
+
+            if (mSource != nullptr)
+            {
+                while (mSize < requiredSize && mEndOfInput == false)
+                {
+                    const std::size_t numOfBytes = mSource->Read(mBuffer.data() + mSize, mBuffer.size() - static_cast<std::size_t>(mSize));
+                    HAVSERILITE_STATS(mStats.mNumOfBytes += numOfBytes);
+
+                    if (numOfBytes == 0)
+                    {
+                        mEndOfInput = true;
+                    }
+
+                    mSize += numOfBytes;
+                }
+            }
+            else if (mSize < requiredSize && mEndOfInput == false)
+            {
+                mStarved = true;
+            }
+
+            return mSize >= requiredSize;
+        }
+
+        bool StartStream(const havSeriLiteStreamOptions& options)
+        {
+            mStreamOptions = options;
+            mStreaming = true;
+            AcquireBuffer();
+            mBuffer.resize(std::max(options.mWindowSize, havSeriLiteHeader::Size));
+            mData = mBuffer.data();
+            mContainerEnds.reserve(64);
+
+            // Note: Pushed chunks may not contain the header yet, so it is read together with the first value.
+            if (mSource == nullptr)
+            {
+                mHeaderPending = true;
+                return true;
+            }
+
+            return ReadHeader();
+        }
+
+        inline void SetContainerEnd(std::int32_t depthLevel, std::uint64_t containerEnd)
+        {
+            if (depthLevel <= 0)
+            {
+                return;
+            }
+
+            if (mContainerEnds.size() < static_cast<std::size_t>(depthLevel))
+            {
+                mContainerEnds.resize(static_cast<std::size_t>(depthLevel));
+            }
+
+            mContainerEnds[depthLevel - 1] = containerEnd;
+        }
+
+        inline std::uint64_t GetContainerEnd(std::int32_t depthLevel) const
+        {
+            if (depthLevel <= 0 || mContainerEnds.size() < static_cast<std::size_t>(depthLevel))
+            {
+                return 0;
+            }
+
+            return mContainerEnds[depthLevel - 1];
+        }
+
+        void ResetSource()
+        {
+            mContainerEnds.clear();
+            mIndexNodes.clear();
+            mIndexEntries.clear();
+            mIndexBuilt = false;
+            mFormatFlags = 0;
+            mDataStart = 0;
+            mMappedFile.Close();
+            mSource.reset();
+            mBuffer.clear();
+            mData = nullptr;
+            mSize = 0;
+            mIndex = 0;
+            mDepthLevel = 0;
+            mBase = 0;
+            mTokenStart = 0;
+            mPendingSkip = 0;
+            mStreaming = false;
+            mEndOfInput = false;
+            mStarved = false;
+            mHeaderPending = false;
+            mStringIds.clear();
+            mStrings.clear();
+            mSchemas.clear();
+            mSchemaChecks.clear();
+            mBorrowedDefinitions = nullptr;
+        }
+
+        // Note: The reader whose dictionary strings and record schemas are used, which is another one for range readers.
+        inline const havSeriLiteReader& GetDefinitions() const { return mBorrowedDefinitions != nullptr ? *mBorrowedDefinitions : *this; }
+
+        // Note: Copies the borrowed definitions before the first definition the reader they are borrowed from does not know, which
+        // only happens for ranges not taken from "SplitContainer".
+        void OwnDefinitions()
+        {
+            if (mBorrowedDefinitions == nullptr)
+            {
+                return;
+            }
+
+            mStrings = mBorrowedDefinitions->mStrings;
+            mSchemas = mBorrowedDefinitions->mSchemas;
+            mStringIds.clear();
+
+            for (std::uint32_t stringId = 0; stringId < mStrings.size(); ++stringId)
+            {
+                mStringIds.emplace(mStrings[stringId], stringId);
+            }
+
+            mBorrowedDefinitions = nullptr;
+        }
+
+        // Note: Takes a buffer from "havSeriLiteBufferPool" if the reader has none yet.
+        inline void AcquireBuffer()
+        {
+            if (mBuffer.capacity() == 0)
+            {
+                mBuffer = havSeriLiteBufferPool::Acquire();
+            }
+        }
+
+        bool SetSource(const char* data, std::size_t size)
+        {
+            HAVSERILITE_STATS(havSeriLiteStatsTimer timer(mStats.mLoadTime));
+
+            return SetSourceImpl(data, size);
+        }
+
+        bool SetSourceImpl(const char* data, std::size_t size)
+        {
+            HAVSERILITE_STATS(mStats.mNumOfBytes += size);
+
+            // Note: Compressed input is decompressed up front (in parallel), so lookups and iteration work as on plain input.
+            if (IsBlockFrame(data, size) == true)
+            {
+                std::vector<char> buffer = havSeriLiteBufferPool::Acquire();
+
+                if (DecompressBlockFrame(data, size, buffer) == false)
+                {
+                    std::cerr << "Error: Corrupt compressed input!" << std::endl;
+                    ResetSource();
+                    return false;
+                }
+
+                mMappedFile.Close();
+                havSeriLiteBufferPool::Release(std::move(mBuffer));
+                mBuffer = std::move(buffer);
+                data = mBuffer.data();
+                size = mBuffer.size();
+            }
+
+            mData = data;
+            mSize = size;
+            mContainerEnds.reserve(64);
+
+            return ReadHeader();
+        }
+
+        bool ReadHeader()
+        {
+            mHeaderPending = false;
+
+            if (havSeriLiteHeader::Size > mSize - mIndex && Refill(havSeriLiteHeader::Size) == false)
+            {
+                // Note: Keep waiting for pushed chunks unless the bytes received so far already rule out the magic.
+                if (mStarved == true && (mIndex == mSize || mData[mIndex] == havSeriLiteHeader::Magic[0]))
+                {
+                    mHeaderPending = true;
+                    return false;
+                }
+
+                mStarved = false;
+                return true;
+            }
+
+            const char* header = &mData[mIndex];
+
+            if (std::memcmp(header, havSeriLiteHeader::Magic, sizeof(havSeriLiteHeader::Magic)) != 0)
+            {
+                return true;
+            }
+
+            const std::uint8_t version = static_cast<std::uint8_t>(header[sizeof(havSeriLiteHeader::Magic)]);
+            const std::uint8_t formatFlags = static_cast<std::uint8_t>(header[sizeof(havSeriLiteHeader::Magic) + 1]);
+
+            if (version > havSeriLiteHeader::Version || (formatFlags & ~havSeriLiteHeader::SupportedFlags) != 0)
+            {
+                HAVSERILITE_STATS(++mStats.mNumOfErrors);
+                HAVSERILITE_STATS(mStats.mLastErrorOffset = GetOffset());
+                std::cerr << "Error: Unsupported format version " << static_cast<int>(version) << " or flags " << static_cast<int>(formatFlags) << "!" << std::endl;
+                ResetSource();
+                return false;
+            }
+
+            mFormatFlags = formatFlags;
+            mIndex += havSeriLiteHeader::Size;
+            mTokenStart = mIndex;
+            mDataStart = GetOffset();
+
+            return true;
+        }
+
+        // Note: View of the bytes being read, either "mBuffer", "mMappedFile" or caller-owned memory.
+        const char* mData;
+        std::vector<char> mBuffer;
+        havSeriLiteMappedFile mMappedFile;
+        // Note: Size of "mData" and position of the cursor in it. For a streamed input "mData" is a window starting at input offset "mBase".
+        std::uint64_t mSize;
+        std::uint64_t mIndex;
+        std::int32_t mDepthLevel;
+        // Note: End offsets of the currently open containers indexed by depth level, zero when unknown.
+        std::vector<std::uint64_t> mContainerEnds;
+        std::vector<havSeriLiteIndexNode> mIndexNodes;
+        std::vector<havSeriLiteIndexEntry> mIndexEntries;
+        bool mIndexBuilt = false;
+        // Note: Format flags from the header and offset of the first value after it, both zero for headerless input.
+        std::uint8_t mFormatFlags = 0;
+        std::uint64_t mDataStart = 0;
+        std::unique_ptr<havSeriLiteSource> mSource;
+        havSeriLiteStreamOptions mStreamOptions;
+        std::uint64_t mBase = 0;
+        // Note: Window position of the value being read, which is kept in the window on refills and rewound to when pushed chunks run out.
+        std::uint64_t mTokenStart = 0;
+        // Note: Bytes of a skipped container that have not been pushed yet.
+        std::uint64_t mPendingSkip = 0;
+        bool mStreaming = false;
+        bool mEndOfInput = false;
+        bool mStarved = false;
+        bool mHeaderPending = false;
+        // Note: Dictionary strings by id. A deque keeps the strings in place, so the map and returned views can refer to them.
+        std::deque<std::string> mStrings;
+        std::unordered_map<std::string_view, std::uint32_t> mStringIds;
+        // Note: Record schemas by id. A deque keeps the schemas in place, so views of their names stay valid like dictionary strings.
+        std::deque<havSeriLiteRecordSchema> mSchemas;
+        std::vector<havSeriLiteSchemaCheck> mSchemaChecks;
+        // Note: Reader whose dictionary strings and record schemas are used instead of the ones above (see "CreateRangeReader").
+        const havSeriLiteReader* mBorrowedDefinitions = nullptr;
+#if HAVSERILITE_ENABLE_STATS
+        havSeriLiteStats mStats;
+#endif
+    };
+
+    // Note: Node of a "havSeriLiteDocument". The children of a container are stored next to each other, object members as a key
+    // node followed by its value node.
+    struct havSeriLiteNode
+    {
+        havSeriLiteValueType mType = havSeriLiteValueType::Null;
+        havSeriLiteValueType mElementType = havSeriLiteValueType::Null;
+        // Note: Length of a string, number of elements of an array or typed array, or number of key-value pairs of an object.
+        std::uint32_t mSize = 0;
+
+        union
+        {
+            std::uint64_t mUInt = 0;
+            std::int64_t mInt;
+            double mDouble;
+            bool mBool;
+            // Note: Characters of a string or elements of a typed array in the reader's input (or its string dictionary or record schemas).
+            const char* mData;
+            // Note: Index of the first child of a container.
+            std::uint64_t mFirstChild;
+        };
+    };
+
+    // Note: Handle to a node of a "havSeriLiteDocument", valid as long as the document is alive and not parsed again. Handles to
+    // missing values (e.g. from a failed lookup) are of type "Null" and have no children.
+    class havSeriLiteElement
+    {
+    public:
+        class Iterator
+        {
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type = havSeriLiteElement;
+            using difference_type = std::ptrdiff_t;
+            using pointer = const havSeriLiteElement*;
+            using reference = havSeriLiteElement;
+
+            Iterator(const havSeriLiteNode* nodes, const havSeriLiteNode* node, bool isMember) : mNodes(nodes), mNode(node), mIsMember(isMember) {}
+
+            inline havSeriLiteElement operator*() const { return havSeriLiteElement { mNodes, mNode, mIsMember }; }
+            inline Iterator& operator++() { mNode += mIsMember == true ? 2 : 1; return *this; }
+            inline Iterator operator++(int) { Iterator result = *this; ++*this; return result; }
+            inline bool operator==(const Iterator& other) const { return mNode == other.mNode; }
+            inline bool operator!=(const Iterator& other) const { return mNode != other.mNode; }
+
+        private:
+            const havSeriLiteNode* mNodes;
+            const havSeriLiteNode* mNode;
+            bool mIsMember;
+        };
+
+        havSeriLiteElement() = default;
+
+        havSeriLiteElement(const havSeriLiteNode* nodes, const havSeriLiteNode* node, bool isMember = false) : mNodes(nodes), mNode(node), mIsMember(isMember) {}
+
+        inline havSeriLiteValueType GetType() const { return mNode != nullptr ? mNode->mType : havSeriLiteValueType::Null; }
+        inline bool IsValid() const { return mNode != nullptr; }
+
+        // Note: Number of elements of an array or typed array, key-value pairs of an object or characters of a string, in constant time.
+        inline std::size_t GetSize() const { return mNode != nullptr ? mNode->mSize : 0; }
+
+        inline std::optional<bool> TryGetBool() const { return GetType() == havSeriLiteValueType::Boolean ? std::optional<bool>(mNode->mBool) : std::nullopt; }
+        inline std::optional<std::int32_t> TryGetInt32() const { return GetType() == havSeriLiteValueType::Int32 ? std::optional<std::int32_t>(static_cast<std::int32_t>(mNode->mInt)) : std::nullopt; }
+        inline std::optional<std::uint32_t> TryGetUInt32() const { return GetType() == havSeriLiteValueType::UInt32 ? std::optional<std::uint32_t>(static_cast<std::uint32_t>(mNode->mUInt)) : std::nullopt; }
+        inline std::optional<std::int64_t> TryGetInt64() const { return GetType() == havSeriLiteValueType::Int64 ? std::optional<std::int64_t>(mNode->mInt) : std::nullopt; }
+        inline std::optional<std::uint64_t> TryGetUInt64() const { return GetType() == havSeriLiteValueType::UInt64 ? std::optional<std::uint64_t>(mNode->mUInt) : std::nullopt; }
+        inline std::optional<double> TryGetDouble() const { return GetType() == havSeriLiteValueType::Double ? std::optional<double>(mNode->mDouble) : std::nullopt; }
+        inline std::optional<std::string_view> TryGetString() const { return GetType() == havSeriLiteValueType::String ? std::optional<std::string_view>(std::string_view { mNode->mData, mNode->mSize }) : std::nullopt; }
+        inline std::optional<std::string_view> TryGetBytes() const { return GetType() == havSeriLiteValueType::Bytes ? std::optional<std::string_view>(std::string_view { mNode->mData, mNode->mSize }) : std::nullopt; }
+
+        // Note: Copies the elements of a typed array in bulk. Fails if the element type does not match "T".
+        template<typename T>
+        bool GetTypedArray(std::vector<T>& values) const
+        {
+            if (GetType() != havSeriLiteValueType::TypedArray || mNode->mElementType != havSeriLiteTypedArrayTraits<T>::ElementType)
+            {
+                return false;
+            }
+
+            values.resize(mNode->mSize);
+
+            if (values.empty() == false)
+            {
+                std::memcpy(values.data(), mNode->mData, values.size() * sizeof(T));
+            }
+
+            return true;
+        }
+
+        // Note: Element "index" of an array or value of member "index" of an object.
+        havSeriLiteElement operator[](std::size_t index) const
+        {
+            if (IsContainer() == false || index >= mNode->mSize)
+            {
+                return havSeriLiteElement {};
+            }
+
+            if (mNode->mType == havSeriLiteValueType::Object)
+            {
+                return havSeriLiteElement { mNodes, mNodes + mNode->mFirstChild + index * 2 + 1, true };
+            }
+
+            return havSeriLiteElement { mNodes, mNodes + mNode->mFirstChild + index };
+        }
+
+        // Note: Looks up a path of object keys and array indices separated by "/" (e.g. "Persons/0/Age"), like "havSeriLiteReader::Find".
+        havSeriLiteElement operator[](std::string_view path) const
+        {
+            havSeriLiteElement element = *this;
+
+            while (path.empty() == false && element.IsValid() == true)
+            {
+                const std::size_t separator = path.find('/');
+                const std::string_view segment = path.substr(0, separator);
+                path = separator == std::string_view::npos ? std::string_view {} : path.substr(separator + 1);
+
+                if (segment.empty() == true)
+                {
+                    continue;
+                }
+
+                if (element.GetType() == havSeriLiteValueType::Object)
+                {
+                    element = element.FindMember(segment);
+                }
+                else
+                {
+                    std::size_t elementIndex = 0;
+                    auto [end, error] = std::from_chars(segment.data(), segment.data() + segment.size(), elementIndex);
+                    element = error == std::errc() && end == segment.data() + segment.size() ? element[elementIndex] : havSeriLiteElement {};
+                }
+            }
+
+            return element;
+        }
+
+        // Note: Key of an object member, for elements obtained from an object by index or iteration.
+        inline havSeriLiteElement GetKey() const { return mIsMember == true ? havSeriLiteElement { mNodes, mNode - 1 } : havSeriLiteElement {}; }
+
+        // Note: Iterates the elements of an array or the member values of an object (see "GetKey").
+        inline Iterator begin() const { return IsContainer() == true ? Iterator { mNodes, mNodes + mNode->mFirstChild + (mNode->mType == havSeriLiteValueType::Object ? 1 : 0), mNode->mType == havSeriLiteValueType::Object } : Iterator { nullptr, nullptr, false }; }
+        inline Iterator end() const { return IsContainer() == true ? Iterator { mNodes, mNodes + mNode->mFirstChild + (mNode->mType == havSeriLiteValueType::Object ? 2 * std::size_t { mNode->mSize } + 1 : mNode->mSize), false } : Iterator { nullptr, nullptr, false }; }
+
+    private:
+        inline bool IsContainer() const { return GetType() == havSeriLiteValueType::Array || GetType() == havSeriLiteValueType::Object; }
+
+        havSeriLiteElement FindMember(std::string_view key) const
+        {
+            const havSeriLiteNode* keys = mNodes + mNode->mFirstChild;
+
+            // Note: Keys are scanned in place, which is fast for the small objects typical of records.
+            for (std::size_t i = 0; i < mNode->mSize; ++i)
+            {
+                const havSeriLiteNode& keyNode = keys[i * 2];
+
+                if (keyNode.mType == havSeriLiteValueType::String && keyNode.mSize == key.size() && (key.empty() == true || std::memcmp(keyNode.mData, key.data(), key.size()) == 0))
+                {
+                    return havSeriLiteElement { mNodes, &keys[i * 2 + 1], true };
+                }
+            }
+
+            return havSeriLiteElement {};
+        }
+
+        const havSeriLiteNode* mNodes = nullptr;
+        const havSeriLiteNode* mNode = nullptr;
+        bool mIsMember = false;
+    };
+
+    // Note: Tree of a whole value, parsed in one pass for repeated traversal. All nodes live in one array that later parses reuse, and
+    // strings and typed arrays refer to the reader's input, so the reader must keep its input while the document is in use.
+    class havSeriLiteDocument
+    {
+    public:
+        havSeriLiteDocument() = default;
+
+        // Note: Parses the next value of "reader", usually the root. Streamed readers are not supported, as their input does not stay in memory.
+        bool Parse(havSeriLiteReader& reader)
+        {
+            HAVSERILITE_STATS(havSeriLiteStatsTimer timer(reader.mStats.mDecodeTime));
+
+            Clear();
+
+            if (reader.mStreaming == true)
+            {
+                std::cerr << "Error: Unable to parse a document from a streamed input!" << std::endl;
+                return false;
+            }
+
+            while (true)
+            {
+                const std::uint64_t tagOffset = reader.GetOffset();
+                havSeriLiteValueView value = reader.ReadValueView();
+
+                if ((value.mType == havSeriLiteValueType::Null && reader.IsNullValueAt(tagOffset) == false) || (value.mType == havSeriLiteValueType::Close && mFrames.empty() == true))
+                {
+                    if (mFrames.empty() == false)
+                    {
+                        std::cerr << "Error: Unexpected end of input in a document!" << std::endl;
+                    }
+
+                    Clear();
+                    return false;
+                }
+
+                havSeriLiteNode node;
+                node.mType = value.mType;
+
+                switch (value.mType)
+                {
+                    case havSeriLiteValueType::Boolean:
+                    case havSeriLiteValueType::Int32:
+                    case havSeriLiteValueType::UInt32:
+                    case havSeriLiteValueType::Int64:
+                    case havSeriLiteValueType::UInt64:
+                    case havSeriLiteValueType::Double:
+                    case havSeriLiteValueType::String:
+                    case havSeriLiteValueType::Bytes:
+                        if (SetScalar(node, value) == false)
+                        {
+                            return false;
+                        }
+                        break;
+                    case havSeriLiteValueType::Record:
+                    {
+                        // Note: Records become objects whose keys refer to the names of the reader's schema. Their fields have no
+                        // children, so they are added to the node array directly.
+                        const std::size_t firstChild = mNodes.size();
+                        bool valid = true;
+
+                        const bool complete = reader.ReadRecordFields(value, [&](std::string_view name, const havSeriLiteValueView& field) {
+                            havSeriLiteNode keyNode;
+                            keyNode.mType = havSeriLiteValueType::String;
+                            keyNode.mSize = static_cast<std::uint32_t>(name.size());
+                            keyNode.mData = name.data();
+                            mNodes.push_back(keyNode);
+
+                            havSeriLiteNode fieldNode;
+                            fieldNode.mType = field.mType;
+                            valid &= SetScalar(fieldNode, field);
+                            mNodes.push_back(fieldNode);
+                        });
+
+                        node.mType = havSeriLiteValueType::Object;
+                        node.mFirstChild = firstChild;
+
+                        if (complete == false || valid == false || SetSize(node, (mNodes.size() - firstChild) / 2) == false)
+                        {
+                            Clear();
+                            return false;
+                        }
+                        break;
+                    }
+                    case havSeriLiteValueType::TypedArray:
+                    {
+                        const havSeriLiteTypedArrayData& typedArray = std::get<havSeriLiteTypedArrayData>(value.mData);
+
+                        if (SetSize(node, typedArray.mCount) == false)
+                        {
+                            return false;
+                        }
+
+                        node.mElementType = typedArray.mElementType;
+                        node.mData = reader.mData + (typedArray.mOffset - reader.mBase);
+                        break;
+                    }
+                    case havSeriLiteValueType::Array:
+                    case havSeriLiteValueType::Object:
+                        // Note: The container node is added once its children are known, see below.
+                        mFrames.push_back(havSeriLiteDocumentFrame { mPending.size(), value.mType });
+                        continue;
+                    case havSeriLiteValueType::Close:
+                    {
+                        // Note: The children collected since the container was opened move to the end of the node array in one block.
+                        const havSeriLiteDocumentFrame frame = mFrames.back();
+                        const std::size_t numOfChildren = mPending.size() - frame.mPendingStart;
+                        mFrames.pop_back();
+
+                        node.mType = frame.mType;
+                        node.mFirstChild = mNodes.size();
+
+                        if ((frame.mType == havSeriLiteValueType::Object && numOfChildren % 2 != 0) || SetSize(node, frame.mType == havSeriLiteValueType::Object ? numOfChildren / 2 : numOfChildren) == false)
+                        {
+                            std::cerr << "Error: Malformed container in a document!" << std::endl;
+                            Clear();
+                            return false;
+                        }
+
+                        mNodes.insert(mNodes.end(), mPending.begin() + frame.mPendingStart, mPending.end());
+                        mPending.resize(frame.mPendingStart);
+                        break;
+                    }
+                    default: break;
+                }
+
+                if (mFrames.empty() == true)
+                {
+                    mNodes.push_back(node);
+                    return true;
+                }
+
+                mPending.push_back(node);
+            }
+        }
+
+        // Note: The root is the last node, as every node is placed after its children.
+        inline havSeriLiteElement GetRoot() const { return mNodes.empty() == false ? havSeriLiteElement { mNodes.data(), &mNodes.back() } : havSeriLiteElement {}; }
+
+        inline std::size_t GetNumOfNodes() const { return mNodes.size(); }
+
+        // Note: Keeps the allocated memory for the next parse.
+        void Clear()
+        {
+            mNodes.clear();
+            mPending.clear();
+            mFrames.clear();
+        }
+
+    private:
+        struct havSeriLiteDocumentFrame
+        {
+            std::size_t mPendingStart;
+            havSeriLiteValueType mType;
+        };
+
+        bool SetScalar(havSeriLiteNode& node, const havSeriLiteValueView& value)
+        {
+            switch (value.mType)
+            {
+                case havSeriLiteValueType::Boolean: node.mBool = std::get<bool>(value.mData); break;
+                case havSeriLiteValueType::Int32:   node.mInt = std::get<std::int32_t>(value.mData); break;
+                case havSeriLiteValueType::UInt32:  node.mUInt = std::get<std::uint32_t>(value.mData); break;
+                case havSeriLiteValueType::Int64:   node.mInt = std::get<std::int64_t>(value.mData); break;
+                case havSeriLiteValueType::UInt64:  node.mUInt = std::get<std::uint64_t>(value.mData); break;
+                case havSeriLiteValueType::Double:  node.mDouble = std::get<double>(value.mData); break;
+                default:
+                    {
+                        const std::string_view string = std::get<std::string_view>(value.mData);
+
+                        if (SetSize(node, string.size()) == false)
+                        {
+                            return false;
+                        }
+
+                        node.mData = string.data();
+                    }
+                    break;
+            }
+
+            return true;
+        }
+
+        bool SetSize(havSeriLiteNode& node, std::uint64_t size)
+        {
+            if (size > std::numeric_limits<std::uint32_t>::max())
+            {
+                std::cerr << "Error: Value too large for a document!" << std::endl;
+                Clear();
+                return false;
+            }
+
+            node.mSize = static_cast<std::uint32_t>(size);
+
+            return true;
+        }
+
+        std::vector<havSeriLiteNode> mNodes;
+        // Note: Children of the open containers, in order of their containers.
+        std::vector<havSeriLiteNode> mPending;
+        std::vector<havSeriLiteDocumentFrame> mFrames;
+    };
+
+    // Note: Member description generated by "HAVSERILITE_FIELDS", mapping a key to a data member of "T".
+    template<typename T, typename M>
+    struct havSeriLiteField
+    {
+        using MemberType = M;
+
+        std::string_view mName;
+        M T::* mMember;
+    };
+
+    // Note: Keys drop the "m" prefix of members following the "mName" convention, so "mFirstName" maps to "FirstName".
+    constexpr std::string_view GetFieldName(std::string_view memberName)
+    {
+        if (memberName.size() > 1 && memberName[0] == 'm' && memberName[1] >= 'A' && memberName[1] <= 'Z')
+        {
+            memberName.remove_prefix(1);
+        }
+
+        return memberName;
+    }
+
+    constexpr std::uint32_t HashFieldName(std::string_view name, std::uint32_t seed)
+    {
+        std::uint32_t hash = 2166136261u ^ seed;
+
+        for (char character : name)
+        {
+            hash ^= static_cast<std::uint8_t>(character);
+            hash *= 16777619u;
+        }
+
+        return hash;
+    }
+
+    // Note: Collision-free key-to-field table computed at compile time by searching for a hash seed.
+    template<std::size_t N>
+    struct havSeriLitePerfectHash
+    {
+        static constexpr std::size_t NoField = N;
+        static constexpr std::size_t MaxTableSize = 8 * (N < 2 ? 2 : N);
+
+        std::uint32_t mSeed = 0;
+        std::uint32_t mMask = 0;
+        std::array<std::uint8_t, MaxTableSize> mTable {};
+        bool mValid = false;
+
+        constexpr havSeriLitePerfectHash(const std::array<std::string_view, N>& names)
+        {
+            for (std::size_t tableSize = 2; tableSize <= MaxTableSize && mValid == false; tableSize *= 2)
+            {
+                if (tableSize < N)
+                {
+                    continue;
+                }
+
+                for (std::uint32_t seed = 0; seed < 256 && mValid == false; ++seed)
+                {
+                    for (auto& slot : mTable)
+                    {
+                        slot = static_cast<std::uint8_t>(NoField);
+                    }
+
+                    bool collision = false;
+
+                    for (std::size_t i = 0; i < N && collision == false; ++i)
+                    {
+                        std::uint8_t& slot = mTable[HashFieldName(names[i], seed) & (tableSize - 1)];
+                        collision = slot != static_cast<std::uint8_t>(NoField);
+                        slot = static_cast<std::uint8_t>(i);
+                    }
+
+                    if (collision == false)
+                    {
+                        mSeed = seed;
+                        mMask = static_cast<std::uint32_t>(tableSize - 1);
+                        mValid = true;
+                    }
+                }
+            }
+        }
+
+        // Note: Returns the candidate field for "name", which still has to be compared once to reject unknown keys.
+        constexpr std::size_t Lookup(std::string_view name) const
+        {
+            return mTable[HashFieldName(name, mSeed) & mMask];
+        }
+    };
+
+    template<typename T, typename = void>
+    struct havSeriLiteIsReflected : std::false_type {};
+
+    template<typename T>
+    struct havSeriLiteIsReflected<T, std::void_t<decltype(havSeriLiteDescribe(static_cast<const T*>(nullptr)))>> : std::true_type {};
+
+    template<typename T>
+    struct havSeriLiteFieldTable
+    {
+        static constexpr auto Fields = havSeriLiteDescribe(static_cast<const T*>(nullptr));
+        static constexpr std::size_t NumOfFields = std::tuple_size_v<std::decay_t<decltype(Fields)>>;
+
+        static_assert(NumOfFields <= 64, "havSeriLite supports at most 64 fields per type");
+
+        static constexpr std::array<std::string_view, NumOfFields> Names = std::apply([](const auto&... fields) {
+            return std::array<std::string_view, NumOfFields> { fields.mName... };
+        }, Fields);
+
+        static constexpr havSeriLitePerfectHash<NumOfFields> Hash { Names };
+
+        static_assert(Hash.mValid == true, "Unable to build a perfect hash for the field names (duplicate names?)");
+
+        static constexpr std::size_t Find(std::string_view name)
+        {
+            const std::size_t index = Hash.Lookup(name);
+            return index < NumOfFields && Names[index] == name ? index : NumOfFields;
+        }
+    };
+
+    template<typename T>
+    struct havSeriLiteRecordFieldTraits { static constexpr havSeriLiteValueType Type = havSeriLiteValueType::Null; };
+
+    template<> struct havSeriLiteRecordFieldTraits<bool> { static constexpr havSeriLiteValueType Type = havSeriLiteValueType::Boolean; };
+    template<> struct havSeriLiteRecordFieldTraits<std::int32_t> { static constexpr havSeriLiteValueType Type = havSeriLiteValueType::Int32; };
+    template<> struct havSeriLiteRecordFieldTraits<std::uint32_t> { static constexpr havSeriLiteValueType Type = havSeriLiteValueType::UInt32; };
+    template<> struct havSeriLiteRecordFieldTraits<std::int64_t> { static constexpr havSeriLiteValueType Type = havSeriLiteValueType::Int64; };
+    template<> struct havSeriLiteRecordFieldTraits<std::uint64_t> { static constexpr havSeriLiteValueType Type = havSeriLiteValueType::UInt64; };
+    template<> struct havSeriLiteRecordFieldTraits<double> { static constexpr havSeriLiteValueType Type = havSeriLiteValueType::Double; };
+    template<> struct havSeriLiteRecordFieldTraits<std::string> { static constexpr havSeriLiteValueType Type = havSeriLiteValueType::String; };
+
+    // Note: Record schema of a type described with "HAVSERILITE_FIELDS", which is supported if all fields are booleans, numbers or strings.
+    template<typename T>
+    struct havSeriLiteRecordLayout
+    {
+        using havSeriLiteTable = havSeriLiteFieldTable<T>;
+
+        static constexpr std::array<havSeriLiteSchemaField, havSeriLiteTable::NumOfFields> Fields = std::apply([](const auto&... fields) {
+            return std::array<havSeriLiteSchemaField, havSeriLiteTable::NumOfFields> { havSeriLiteSchemaField { fields.mName, havSeriLiteRecordFieldTraits<typename std::decay_t<decltype(fields)>::MemberType>::Type }... };
+        }, havSeriLiteTable::Fields);
+
+        static constexpr bool IsSupported = std::apply([](const auto&... fields) {
+            return ((havSeriLiteRecordFieldTraits<typename std::decay_t<decltype(fields)>::MemberType>::Type != havSeriLiteValueType::Null) && ...);
+        }, havSeriLiteTable::Fields);
+
+        template<typename M>
+        static inline const char* DecodeField(const char* data, M& value)
+        {
+            if constexpr (std::is_same_v<M, std::string>)
+            {
+                const std::size_t stringSize = static_cast<std::size_t>(DecodeVarint(data));
+                value.assign(data, stringSize);
+                return data + stringSize;
+            }
+            else if constexpr (std::is_same_v<M, bool>)
+            {
+                value = *data != 0;
+                return data + 1;
+            }
+            else
+            {
+                std::memcpy(&value, data, sizeof(M));
+                return data + sizeof(M);
+            }
+        }
+    };
+
+    template<typename T>
+    inline void Write(havSeriLiteWriter& writer, const T& value)
+    {
+        havSeriLiteSerializer<T>::Write(writer, value);
+    }
+
+    // Note: Decodes "value", which has just been read from "reader", into "result". Nested arrays and objects are read from "reader".
+    template<typename T>
+    inline bool Read(havSeriLiteReader& reader, const havSeriLiteValueView& value, T& result)
+    {
+        return havSeriLiteSerializer<T>::Read(reader, value, result);
+    }
+
+    template<typename T>
+    inline bool Read(havSeriLiteReader& reader, T& result)
+    {
+        return Read(reader, reader.ReadValueView(), result);
+    }
+
+    // Note: Writes "values" as an array, encoding the elements on "numOfThreads" threads (all cores if zero) into shards that are
+    // appended in order (see "havSeriLiteWriter::CreateShard"). Numeric elements are written as a typed array on the calling thread.
+    template<typename T>
+    void WriteParallel(havSeriLiteWriter& writer, const std::vector<T>& values, std::size_t numOfThreads = 0)
+    {
+        if (numOfThreads == 0)
+        {
+            numOfThreads = std::max<std::size_t>(std::thread::hardware_concurrency(), 1);
+        }
+
+        if constexpr (havSeriLiteSerializer<std::vector<T>>::template havSeriLiteIsTypedArrayElement<T>::value == true)
+        {
+            Write(writer, values);
+            return;
+        }
+
+        // Note: More shards than threads balance the load when elements differ in size.
+        const std::size_t numOfShards = std::min(values.size(), numOfThreads * 4);
+
+        if (numOfThreads == 1 || numOfShards <= 1)
+        {
+            Write(writer, values);
+            return;
+        }
+
+        std::vector<havSeriLiteWriter> shards;
+        shards.reserve(numOfShards);
+
+        for (std::size_t i = 0; i < numOfShards; ++i)
+        {
+            shards.push_back(writer.CreateShard());
+        }
+
+        std::atomic<std::size_t> nextShard { 0 };
+
+        auto Worker = [&]() {
+            for (std::size_t i = nextShard++; i < numOfShards; i = nextShard++)
+            {
+                const std::size_t first = i * values.size() / numOfShards;
+                const std::size_t last = (i + 1) * values.size() / numOfShards;
+
+                for (std::size_t element = first; element < last; ++element)
+                {
+                    Write(shards[i], values[element]);
+                }
+            }
+        };
+
+        std::vector<std::thread> threads;
+
+        for (std::size_t i = 1; i < std::min(numOfThreads, numOfShards); ++i)
+        {
+            threads.emplace_back(Worker);
+        }
+
+        Worker();
+
+        for (std::thread& thread : threads)
+        {
+            thread.join();
+        }
+
+        writer.WriteArray();
+        writer.WriteShards(shards.data(), shards.size());
+        writer.WriteClose();
+    }
+
+    // Note: Decodes the elements of the array "value", which has just been read from "reader", into "result" on "numOfThreads"
+    // threads (see "havSeriLiteReader::DecodeParallel").
+    template<typename T>
+    bool ReadParallel(havSeriLiteReader& reader, const havSeriLiteValueView& value, std::vector<T>& result, std::size_t numOfThreads = 0)
+    {
+        struct havSeriLiteRangeResult
+        {
+            std::vector<T> mValues;
+            bool mValid = false;
+        };
+
+        if (numOfThreads == 0)
+        {
+            numOfThreads = std::max<std::size_t>(std::thread::hardware_concurrency(), 1);
+        }
+
+        // Note: Splitting only pays off when the ranges are decoded concurrently.
+        if (numOfThreads == 1)
+        {
+            return value.mType == havSeriLiteValueType::Array && Read(reader, value, result);
+        }
+
+        std::vector<havSeriLiteRangeResult> rangeResults;
+
+        if (value.mType != havSeriLiteValueType::Array || reader.DecodeParallel(value, [](havSeriLiteReader& rangeReader, const havSeriLiteElementRange& range) {
+            havSeriLiteRangeResult rangeResult;
+            rangeResult.mValues.resize(static_cast<std::size_t>(range.mNumOfElements));
+            rangeResult.mValid = true;
+
+            for (T& element : rangeResult.mValues)
+            {
+                rangeResult.mValid &= Read(rangeReader, element);
+            }
+
+            return rangeResult;
+        }, rangeResults, numOfThreads) == false)
+        {
+            return false;
+        }
+
+        bool valid = true;
+        std::size_t numOfElements = 0;
+
+        for (const havSeriLiteRangeResult& rangeResult : rangeResults)
+        {
+            valid &= rangeResult.mValid;
+            numOfElements += rangeResult.mValues.size();
+        }
+
+        result.clear();
+        result.reserve(numOfElements);
+
+        for (havSeriLiteRangeResult& rangeResult : rangeResults)
+        {
+            std::move(rangeResult.mValues.begin(), rangeResult.mValues.end(), std::back_inserter(result));
+        }
+
+        return valid;
+    }
+
+    template<>
+    struct havSeriLiteSerializer<bool>
+    {
+        static void Write(havSeriLiteWriter& writer, bool value) { writer.WriteBool(value); }
+        static bool Read(havSeriLiteReader& reader, const havSeriLiteValueView& value, bool& result) { return Assign(reader.TryReadBool(value), result); }
+
+        template<typename U>
+        static bool Assign(const std::optional<U>& source, U& result)
+        {
+            if (source.has_value() == true)
+            {
+                result = *source;
+            }
+
+            return source.has_value();
+        }
+    };
+
+    template<>
+    struct havSeriLiteSerializer<std::int32_t>
+    {
+        static void Write(havSeriLiteWriter& writer, std::int32_t value) { writer.WriteInt32(value); }
+        static bool Read(havSeriLiteReader& reader, const havSeriLiteValueView& value, std::int32_t& result) { return havSeriLiteSerializer<bool>::Assign(reader.TryReadInt32(value), result); }
+    };
+
+    template<>
+    struct havSeriLiteSerializer<std::uint32_t>
+    {
+        static void Write(havSeriLiteWriter& writer, std::uint32_t value) { writer.WriteUInt32(value); }
+        static bool Read(havSeriLiteReader& reader, const havSeriLiteValueView& value, std::uint32_t& result) { return havSeriLiteSerializer<bool>::Assign(reader.TryReadUInt32(value), result); }
+    };
+
+    template<>
+    struct havSeriLiteSerializer<std::int64_t>
+    {
+        static void Write(havSeriLiteWriter& writer, std::int64_t value) { writer.WriteInt64(value); }
+        static bool Read(havSeriLiteReader& reader, const havSeriLiteValueView& value, std::int64_t& result) { return havSeriLiteSerializer<bool>::Assign(reader.TryReadInt64(value), result); }
+    };
+
+    template<>
+    struct havSeriLiteSerializer<std::uint64_t>
+    {
+        static void Write(havSeriLiteWriter& writer, std::uint64_t value) { writer.WriteUInt64(value); }
+        static bool Read(havSeriLiteReader& reader, const havSeriLiteValueView& value, std::uint64_t& result) { return havSeriLiteSerializer<bool>::Assign(reader.TryReadUInt64(value), result); }
+    };
+
+    template<>
+    struct havSeriLiteSerializer<double>
+    {
+        static void Write(havSeriLiteWriter& writer, double value) { writer.WriteDouble(value); }
+        static bool Read(havSeriLiteReader& reader, const havSeriLiteValueView& value, double& result) { return havSeriLiteSerializer<bool>::Assign(reader.TryReadDouble(value), result); }
+    };
+
+    template<>
+    struct havSeriLiteSerializer<std::string>
+    {
+        static void Write(havSeriLiteWriter& writer, const std::string& value) { writer.WriteString(value); }
+
+        static bool Read(havSeriLiteReader& reader, const havSeriLiteValueView& value, std::string& result)
+        {
+            auto stringView = reader.TryReadStringView(value);
+
+            if (stringView.has_value() == true)
+            {
+                result.assign(stringView->data(), stringView->size());
+            }
+
+            return stringView.has_value();
+        }
+    };
+
+    // Note: Empty optionals are written as "Null" values, or left out entirely when used as a field.
+    template<typename T>
+    struct havSeriLiteSerializer<std::optional<T>>
+    {
+        static void Write(havSeriLiteWriter& writer, const std::optional<T>& value)
+        {
+            if (value.has_value() == true)
+            {
+                havSeriLiteSerializer<T>::Write(writer, *value);
+            }
+            else
+            {
+                writer.WriteNull();
+            }
+        }
+
+        static bool Read(havSeriLiteReader& reader, const havSeriLiteValueView& value, std::optional<T>& result)
+        {
+            if (value.mType == havSeriLiteValueType::Null)
+            {
+                result.reset();
+                return true;
+            }
+
+            if (result.has_value() == false)
+            {
+                result.emplace();
+            }
+
+            return havSeriLiteSerializer<T>::Read(reader, value, *result);
+        }
+    };
+
+    // Note: Vectors of typed array element types are written as typed arrays, all other vectors as arrays. Both are accepted when reading.
+    template<typename T>
+    struct havSeriLiteSerializer<std::vector<T>>
+    {
+        template<typename U, typename = void>
+        struct havSeriLiteIsTypedArrayElement : std::false_type {};
+
+        template<typename U>
+        struct havSeriLiteIsTypedArrayElement<U, std::void_t<decltype(havSeriLiteTypedArrayTraits<U>::ElementType)>> : std::true_type {};
+
+        static void Write(havSeriLiteWriter& writer, const std::vector<T>& value)
+        {
+            if constexpr (havSeriLiteIsTypedArrayElement<T>::value == true)
+            {
+                writer.WriteTypedArray(value);
+            }
+            else
+            {
+                writer.WriteArray();
+                for (const T& element : value)
+                {
+                    havSeriLiteSerializer<T>::Write(writer, element);
+                }
+                writer.WriteClose();
+            }
+        }
+
+        static bool Read(havSeriLiteReader& reader, const havSeriLiteValueView& value, std::vector<T>& result)
+        {
+            if constexpr (havSeriLiteIsTypedArrayElement<T>::value == true)
+            {
+                if (value.mType == havSeriLiteValueType::TypedArray)
+                {
+                    return reader.ReadTypedArray(value, result);
+                }
+            }
+
+            if (value.mType != havSeriLiteValueType::Array)
+            {
+                return false;
+            }
+
+            if (auto container = reader.TryReadContainer(value); container.has_value() == true && container->mCount > 0)
+            {
+                result.reserve(static_cast<std::size_t>(container->mCount));
+            }
+
+            result.clear();
+
+            havSeriLiteValueView element { nullptr, havSeriLiteValueType::Null };
+
+            while (reader.ArrayIterator(value.mDepthLevel, element) == true)
+            {
+                result.emplace_back();
+
+                if (havSeriLiteSerializer<T>::Read(reader, element, result.back()) == false)
+                {
+                    return false;
+                }
+            }
+
+            return true;
+        }
+    };
+
+    // Note: Types described with "HAVSERILITE_FIELDS" are written as objects with one key per field. Unknown keys are skipped
+    // when reading, missing fields are an error unless they are optional.
+    template<typename T>
+    struct havSeriLiteSerializer<T, std::enable_if_t<havSeriLiteIsReflected<T>::value>>
+    {
+        using havSeriLiteTable = havSeriLiteFieldTable<T>;
+
+        template<typename M>
+        struct havSeriLiteIsOptional : std::false_type {};
+
+        template<typename M>
+        struct havSeriLiteIsOptional<std::optional<M>> : std::true_type {};
+
+        using havSeriLiteLayout = havSeriLiteRecordLayout<T>;
+
+        static void Write(havSeriLiteWriter& writer, const T& value)
+        {
+            if constexpr (havSeriLiteLayout::IsSupported == true)
+            {
+                if (writer.BeginRecord(havSeriLiteLayout::Fields.data(), havSeriLiteLayout::Fields.size()) == true)
+                {
+                    std::apply([&](const auto&... fields) {
+                        (writer.WriteRecordField(value.*(fields.mMember)), ...);
+                    }, havSeriLiteTable::Fields);
+                    return;
+                }
+            }
+
+            writer.WriteObject();
+            std::apply([&](const auto&... fields) {
+                (WriteField(writer, fields, value), ...);
+            }, havSeriLiteTable::Fields);
+            writer.WriteClose();
+        }
+
+        static bool Read(havSeriLiteReader& reader, const havSeriLiteValueView& value, T& result)
+        {
+            if (value.mType == havSeriLiteValueType::Record)
+            {
+                return ReadRecord(reader, value, result);
+            }
+
+            if (value.mType != havSeriLiteValueType::Object)
+            {
+                return false;
+            }
+
+            std::uint64_t foundFields = 0;
+            bool valid = true;
+
+            havSeriLiteValueView key { nullptr, havSeriLiteValueType::Null };
+            havSeriLiteValueView member { nullptr, havSeriLiteValueType::Null };
+
+            while (reader.ObjectIterator(value.mDepthLevel, key, member) == true)
+            {
+                auto keyName = reader.TryReadStringView(key);
+
+                if (keyName.has_value() == false)
+                {
+                    continue;
+                }
+
+                const std::size_t index = havSeriLiteTable::Find(*keyName);
+
+                if (index < havSeriLiteTable::NumOfFields)
+                {
+                    valid &= ReadField(reader, index, member, result, std::make_index_sequence<havSeriLiteTable::NumOfFields> {});
+                    foundFields |= std::uint64_t { 1 } << index;
+                }
+            }
+
+            return valid == true && (foundFields & GetRequiredFields()) == GetRequiredFields();
+        }
+
+    private:
+        // Note: Records written from "T" are decoded as a fixed sequence of loads, records of other schemas by name like objects.
+        static bool ReadRecord(havSeriLiteReader& reader, const havSeriLiteValueView& value, T& result)
+        {
+            if constexpr (havSeriLiteLayout::IsSupported == true)
+            {
+                if (const char* data = reader.TryReadRecordPayload(value, havSeriLiteLayout::Fields.data(), havSeriLiteLayout::Fields.size()); data != nullptr)
+                {
+                    std::apply([&](const auto&... fields) {
+                        ((data = havSeriLiteLayout::DecodeField(data, result.*(fields.mMember))), ...);
+                    }, havSeriLiteTable::Fields);
+                    return true;
+                }
+            }
+
+            std::uint64_t foundFields = 0;
+            bool valid = true;
+
+            const bool complete = reader.ReadRecordFields(value, [&](std::string_view name, const havSeriLiteValueView& field) {
+                const std::size_t index = havSeriLiteTable::Find(name);
+
+                if (index < havSeriLiteTable::NumOfFields)
+                {
+                    valid &= ReadField(reader, index, field, result, std::make_index_sequence<havSeriLiteTable::NumOfFields> {});
+                    foundFields |= std::uint64_t { 1 } << index;
+                }
+            });
+
+            return complete == true && valid == true && (foundFields & GetRequiredFields()) == GetRequiredFields();
+        }
+
+        template<typename Field>
+        static void WriteField(havSeriLiteWriter& writer, const Field& field, const T& value)
+        {
+            const auto& member = value.*(field.mMember);
+
+            if constexpr (havSeriLiteIsOptional<typename Field::MemberType>::value == true)
+            {
+                if (member.has_value() == false)
+                {
+                    return;
+                }
+            }
+
+            writer.WriteString(field.mName);
+            havSeriLiteSerializer<typename Field::MemberType>::Write(writer, member);
+        }
+
+        template<std::size_t... I>
+        static bool ReadField(havSeriLiteReader& reader, std::size_t index, const havSeriLiteValueView& value, T& result, std::index_sequence<I...>)
+        {
+            bool valid = false;
+            ((index == I ? (valid = ReadMember<I>(reader, value, result), true) : false) || ...);
+            return valid;
+        }
+
+        template<std::size_t I>
+        static bool ReadMember(havSeriLiteReader& reader, const havSeriLiteValueView& value, T& result)
+        {
+            const auto& field = std::get<I>(havSeriLiteTable::Fields);
+            using MemberType = typename std::decay_t<decltype(field)>::MemberType;
+            return havSeriLiteSerializer<MemberType>::Read(reader, value, result.*(field.mMember));
+        }
+
+        static constexpr std::uint64_t GetRequiredFields()
+        {
+            return std::apply([](const auto&... fields) {
+                std::uint64_t requiredFields = 0;
+                std::size_t index = 0;
+                ((requiredFields |= (havSeriLiteIsOptional<typename std::decay_t<decltype(fields)>::MemberType>::value == true ? 0 : std::uint64_t { 1 } << index), ++index), ...);
+                return requiredFields;
+            }, havSeriLiteTable::Fields);
+        }
+    };
+}
+
+#define HAVSERILITE_EXPAND(x) x
+#define HAVSERILITE_FOR_EACH_1(macro, type, a) macro(type, a)
+#define HAVSERILITE_FOR_EACH_2(macro, type, a, ...) macro(type, a), HAVSERILITE_EXPAND(HAVSERILITE_FOR_EACH_1(macro, type, __VA_ARGS__))
+#define HAVSERILITE_FOR_EACH_3(macro, type, a, ...) macro(type, a), HAVSERILITE_EXPAND(HAVSERILITE_FOR_EACH_2(macro, type, __VA_ARGS__))
+#define HAVSERILITE_FOR_EACH_4(macro, type, a, ...) macro(type, a), HAVSERILITE_EXPAND(HAVSERILITE_FOR_EACH_3(macro, type, __VA_ARGS__))
+#define HAVSERILITE_FOR_EACH_5(macro, type, a, ...) macro(type, a), HAVSERILITE_EXPAND(HAVSERILITE_FOR_EACH_4(macro, type, __VA_ARGS__))
+#define HAVSERILITE_FOR_EACH_6(macro, type, a, ...) macro(type, a), HAVSERILITE_EXPAND(HAVSERILITE_FOR_EACH_5(macro, type, __VA_ARGS__))
+#define HAVSERILITE_FOR_EACH_7(macro, type, a, ...) macro(type, a), HAVSERILITE_EXPAND(HAVSERILITE_FOR_EACH_6(macro, type, __VA_ARGS__))
+#define HAVSERILITE_FOR_EACH_8(macro, type, a, ...) macro(type, a), HAVSERILITE_EXPAND(HAVSERILITE_FOR_EACH_7(macro, type, __VA_ARGS__))
+#define HAVSERILITE_FOR_EACH_9(macro, type, a, ...) macro(type, a), HAVSERILITE_EXPAND(HAVSERILITE_FOR_EACH_8(macro, type, __VA_ARGS__))
+#define HAVSERILITE_FOR_EACH_10(macro, type, a, ...) macro(type, a), HAVSERILITE_EXPAND(HAVSERILITE_FOR_EACH_9(macro, type, __VA_ARGS__))
+#define HAVSERILITE_FOR_EACH_11(macro, type, a, ...) macro(type, a), HAVSERILITE_EXPAND(HAVSERILITE_FOR_EACH_10(macro, type, __VA_ARGS__))
+#define HAVSERILITE_FOR_EACH_12(macro, type, a, ...) macro(type, a), HAVSERILITE_EXPAND(HAVSERILITE_FOR_EACH_11(macro, type, __VA_ARGS__))
+#define HAVSERILITE_FOR_EACH_13(macro, type, a, ...) macro(type, a), HAVSERILITE_EXPAND(HAVSERILITE_FOR_EACH_12(macro, type, __VA_ARGS__))
+#define HAVSERILITE_FOR_EACH_14(macro, type, a, ...) macro(type, a), HAVSERILITE_EXPAND(HAVSERILITE_FOR_EACH_13(macro, type, __VA_ARGS__))
+#define HAVSERILITE_FOR_EACH_15(macro, type, a, ...) macro(type, a), HAVSERILITE_EXPAND(HAVSERILITE_FOR_EACH_14(macro, type, __VA_ARGS__))
+#define HAVSERILITE_FOR_EACH_16(macro, type, a, ...) macro(type, a), HAVSERILITE_EXPAND(HAVSERILITE_FOR_EACH_15(macro, type, __VA_ARGS__))
+#define HAVSERILITE_FOR_EACH_17(macro, type, a, ...) macro(type, a), HAVSERILITE_EXPAND(HAVSERILITE_FOR_EACH_16(macro, type, __VA_ARGS__))
+#define HAVSERILITE_FOR_EACH_18(macro, type, a, ...) macro(type, a), HAVSERILITE_EXPAND(HAVSERILITE_FOR_EACH_17(macro, type, __VA_ARGS__))
+#define HAVSERILITE_FOR_EACH_19(macro, type, a, ...) macro(type, a), HAVSERILITE_EXPAND(HAVSERILITE_FOR_EACH_18(macro, type, __VA_ARGS__))
+#define HAVSERILITE_FOR_EACH_20(macro, type, a, ...) macro(type, a), HAVSERILITE_EXPAND(HAVSERILITE_FOR_EACH_19(macro, type, __VA_ARGS__))
+#define HAVSERILITE_FOR_EACH_21(macro, type, a, ...) macro(type, a), HAVSERILITE_EXPAND(HAVSERILITE_FOR_EACH_20(macro, type, __VA_ARGS__))
+#define HAVSERILITE_FOR_EACH_22(macro, type, a, ...) macro(type, a), HAVSERILITE_EXPAND(HAVSERILITE_FOR_EACH_21(macro, type, __VA_ARGS__))
+#define HAVSERILITE_FOR_EACH_23(macro, type, a, ...) macro(type, a), HAVSERILITE_EXPAND(HAVSERILITE_FOR_EACH_22(macro, type, __VA_ARGS__))
+#define HAVSERILITE_FOR_EACH_24(macro, type, a, ...) macro(type, a), HAVSERILITE_EXPAND(HAVSERILITE_FOR_EACH_23(macro, type, __VA_ARGS__))
+#define HAVSERILITE_FOR_EACH_25(macro, type, a, ...) macro(type, a), HAVSERILITE_EXPAND(HAVSERILITE_FOR_EACH_24(macro, type, __VA_ARGS__))
+#define HAVSERILITE_FOR_EACH_26(macro, type, a, ...) macro(type, a), HAVSERILITE_EXPAND(HAVSERILITE_FOR_EACH_25(macro, type, __VA_ARGS__))
+#define HAVSERILITE_FOR_EACH_27(macro, type, a, ...) macro(type, a), HAVSERILITE_EXPAND(HAVSERILITE_FOR_EACH_26(macro, type, __VA_ARGS__))
+#define HAVSERILITE_FOR_EACH_28(macro, type, a, ...) macro(type, a), HAVSERILITE_EXPAND(HAVSERILITE_FOR_EACH_27(macro, type, __VA_ARGS__))
+#define HAVSERILITE_FOR_EACH_29(macro, type, a, ...) macro(type, a), HAVSERILITE_EXPAND(HAVSERILITE_FOR_EACH_28(macro, type, __VA_ARGS__))
+#define HAVSERILITE_FOR_EACH_30(macro, type, a, ...) macro(type, a), HAVSERILITE_EXPAND(HAVSERILITE_FOR_EACH_29(macro, type, __VA_ARGS__))
+#define HAVSERILITE_FOR_EACH_31(macro, type, a, ...) macro(type, a), HAVSERILITE_EXPAND(HAVSERILITE_FOR_EACH_30(macro, type, __VA_ARGS__))
+#define HAVSERILITE_FOR_EACH_32(macro, type, a, ...) macro(type, a), HAVSERILITE_EXPAND(HAVSERILITE_FOR_EACH_31(macro, type, __VA_ARGS__))
+#define HAVSERILITE_FOR_EACH_33(macro, type, a, ...) macro(type, a), HAVSERILITE_EXPAND(HAVSERILITE_FOR_EACH_32(macro, type, __VA_ARGS__))
+#define HAVSERILITE_FOR_EACH_34(macro, type, a, ...) macro(type, a), HAVSERILITE_EXPAND(HAVSERILITE_FOR_EACH_33(macro, type, __VA_ARGS__))
+#define HAVSERILITE_FOR_EACH_35(macro, type, a, ...) macro(type, a), HAVSERILITE_EXPAND(HAVSERILITE_FOR_EACH_34(macro, type, __VA_ARGS__))
+#define HAVSERILITE_FOR_EACH_36(macro, type, a, ...) macro(type, a), HAVSERILITE_EXPAND(HAVSERILITE_FOR_EACH_35(macro, type, __VA_ARGS__))
+#define HAVSERILITE_FOR_EACH_37(macro, type, a, ...) macro(type, a), HAVSERILITE_EXPAND(HAVSERILITE_FOR_EACH_36(macro, type, __VA_ARGS__))
+#define HAVSERILITE_FOR_EACH_38(macro, type, a, ...) macro(type, a), HAVSERILITE_EXPAND(HAVSERILITE_FOR_EACH_37(macro, type, __VA_ARGS__))
+#define HAVSERILITE_FOR_EACH_39(macro, type, a, ...) macro(type, a), HAVSERILITE_EXPAND(HAVSERILITE_FOR_EACH_38(macro, type, __VA_ARGS__))
+#define HAVSERILITE_FOR_EACH_40(macro, type, a, ...) macro(type, a), HAVSERILITE_EXPAND(HAVSERILITE_FOR_EACH_39(macro, type, __VA_ARGS__))
+#define HAVSERILITE_FOR_EACH_41(macro, type, a, ...) macro(type, a), HAVSERILITE_EXPAND(HAVSERILITE_FOR_EACH_40(macro, type, __VA_ARGS__))
+#define HAVSERILITE_FOR_EACH_42(macro, type, a, ...) macro(type, a), HAVSERILITE_EXPAND(HAVSERILITE_FOR_EACH_41(macro, type, __VA_ARGS__))
+#define HAVSERILITE_FOR_EACH_43(macro, type, a, ...) macro(type, a), HAVSERILITE_EXPAND(HAVSERILITE_FOR_EACH_42(macro, type, __VA_ARGS__))
+#define HAVSERILITE_FOR_EACH_44(macro, type, a, ...) macro(type, a), HAVSERILITE_EXPAND(HAVSERILITE_FOR_EACH_43(macro, type, __VA_ARGS__))
+#define HAVSERILITE_FOR_EACH_45(macro, type, a, ...) macro(type, a), HAVSERILITE_EXPAND(HAVSERILITE_FOR_EACH_44(macro, type, __VA_ARGS__))
+#define HAVSERILITE_FOR_EACH_46(macro, type, a, ...) macro(type, a), HAVSERILITE_EXPAND(HAVSERILITE_FOR_EACH_45(macro, type, __VA_ARGS__))
+#define HAVSERILITE_FOR_EACH_47(macro, type, a, ...) macro(type, a), HAVSERILITE_EXPAND(HAVSERILITE_FOR_EACH_46(macro, type, __VA_ARGS__))
+#define HAVSERILITE_FOR_EACH_48(macro, type, a, ...) macro(type, a), HAVSERILITE_EXPAND(HAVSERILITE_FOR_EACH_47(macro, type, __VA_ARGS__))
+#define HAVSERILITE_FOR_EACH_49(macro, type, a, ...) macro(type, a), HAVSERILITE_EXPAND(HAVSERILITE_FOR_EACH_48(macro, type, __VA_ARGS__))
+#define HAVSERILITE_FOR_EACH_50(macro, type, a, ...) macro(type, a), HAVSERILITE_EXPAND(HAVSERILITE_FOR_EACH_49(macro, type, __VA_ARGS__))
+#define HAVSERILITE_FOR_EACH_51(macro, type, a, ...) macro(type, a), HAVSERILITE_EXPAND(HAVSERILITE_FOR_EACH_50(macro, type, __VA_ARGS__))
+#define HAVSERILITE_FOR_EACH_52(macro, type, a, ...) macro(type, a), HAVSERILITE_EXPAND(HAVSERILITE_FOR_EACH_51(macro, type, __VA_ARGS__))
+#define HAVSERILITE_FOR_EACH_53(macro, type, a, ...) macro(type, a), HAVSERILITE_EXPAND(HAVSERILITE_FOR_EACH_52(macro, type, __VA_ARGS__))
+#define HAVSERILITE_FOR_EACH_54(macro, type, a, ...) macro(type, a), HAVSERILITE_EXPAND(HAVSERILITE_FOR_EACH_53(macro, type, __VA_ARGS__))
+#define HAVSERILITE_FOR_EACH_55(macro, type, a, ...) macro(type, a), HAVSERILITE_EXPAND(HAVSERILITE_FOR_EACH_54(macro, type, __VA_ARGS__))
+#define HAVSERILITE_FOR_EACH_56(macro, type, a, ...) macro(type, a), HAVSERILITE_EXPAND(HAVSERILITE_FOR_EACH_55(macro, type, __VA_ARGS__))
+#define HAVSERILITE_FOR_EACH_57(macro, type, a, ...) macro(type, a), HAVSERILITE_EXPAND(HAVSERILITE_FOR_EACH_56(macro, type, __VA_ARGS__))
+#define HAVSERILITE_FOR_EACH_58(macro, type, a, ...) macro(type, a), HAVSERILITE_EXPAND(HAVSERILITE_FOR_EACH_57(macro, type, __VA_ARGS__))
+#define HAVSERILITE_FOR_EACH_59(macro, type, a, ...) macro(type, a), HAVSERILITE_EXPAND(HAVSERILITE_FOR_EACH_58(macro, type, __VA_ARGS__))
+#define HAVSERILITE_FOR_EACH_60(macro, type, a, ...) macro(type, a), HAVSERILITE_EXPAND(HAVSERILITE_FOR_EACH_59(macro, type, __VA_ARGS__))
+#define HAVSERILITE_FOR_EACH_61(macro, type, a, ...) macro(type, a), HAVSERILITE_EXPAND(HAVSERILITE_FOR_EACH_60(macro, type, __VA_ARGS__))
+#define HAVSERILITE_FOR_EACH_62(macro, type, a, ...) macro(type, a), HAVSERILITE_EXPAND(HAVSERILITE_FOR_EACH_61(macro, type, __VA_ARGS__))
+#define HAVSERILITE_FOR_EACH_63(macro, type, a, ...) macro(type, a), HAVSERILITE_EXPAND(HAVSERILITE_FOR_EACH_62(macro, type, __VA_ARGS__))
+#define HAVSERILITE_FOR_EACH_64(macro, type, a, ...) macro(type, a), HAVSERILITE_EXPAND(HAVSERILITE_FOR_EACH_63(macro, type, __VA_ARGS__))
+#define HAVSERILITE_SELECT_FOR_EACH(_1, _2, _3, _4, _5, _6, _7, _8, _9, _10, _11, _12, _13, _14, _15, _16, _17, _18, _19, _20, _21, _22, _23, _24, _25, _26, _27, _28, _29, _30, _31, _32, _33, _34, _35, _36, _37, _38, _39, _40, _41, _42, _43, _44, _45, _46, _47, _48, _49, _50, _51, _52, _53, _54, _55, _56, _57, _58, _59, _60, _61, _62, _63, _64, name, ...) name
+#define HAVSERILITE_FOR_EACH(macro, type, ...) HAVSERILITE_EXPAND(HAVSERILITE_SELECT_FOR_EACH(__VA_ARGS__, HAVSERILITE_FOR_EACH_64, HAVSERILITE_FOR_EACH_63, HAVSERILITE_FOR_EACH_62, HAVSERILITE_FOR_EACH_61, HAVSERILITE_FOR_EACH_60, HAVSERILITE_FOR_EACH_59, HAVSERILITE_FOR_EACH_58, HAVSERILITE_FOR_EACH_57, HAVSERILITE_FOR_EACH_56, HAVSERILITE_FOR_EACH_55, HAVSERILITE_FOR_EACH_54, HAVSERILITE_FOR_EACH_53, HAVSERILITE_FOR_EACH_52, HAVSERILITE_FOR_EACH_51, HAVSERILITE_FOR_EACH_50, HAVSERILITE_FOR_EACH_49, HAVSERILITE_FOR_EACH_48, HAVSERILITE_FOR_EACH_47, HAVSERILITE_FOR_EACH_46, HAVSERILITE_FOR_EACH_45, HAVSERILITE_FOR_EACH_44, HAVSERILITE_FOR_EACH_43, HAVSERILITE_FOR_EACH_42, HAVSERILITE_FOR_EACH_41, HAVSERILITE_FOR_EACH_40, HAVSERILITE_FOR_EACH_39, HAVSERILITE_FOR_EACH_38, HAVSERILITE_FOR_EACH_37, HAVSERILITE_FOR_EACH_36, HAVSERILITE_FOR_EACH_35, HAVSERILITE_FOR_EACH_34, HAVSERILITE_FOR_EACH_33, HAVSERILITE_FOR_EACH_32, HAVSERILITE_FOR_EACH_31, HAVSERILITE_FOR_EACH_30, HAVSERILITE_FOR_EACH_29, HAVSERILITE_FOR_EACH_28, HAVSERILITE_FOR_EACH_27, HAVSERILITE_FOR_EACH_26, HAVSERILITE_FOR_EACH_25, HAVSERILITE_FOR_EACH_24, HAVSERILITE_FOR_EACH_23, HAVSERILITE_FOR_EACH_22, HAVSERILITE_FOR_EACH_21, HAVSERILITE_FOR_EACH_20, HAVSERILITE_FOR_EACH_19, HAVSERILITE_FOR_EACH_18, HAVSERILITE_FOR_EACH_17, HAVSERILITE_FOR_EACH_16, HAVSERILITE_FOR_EACH_15, HAVSERILITE_FOR_EACH_14, HAVSERILITE_FOR_EACH_13, HAVSERILITE_FOR_EACH_12, HAVSERILITE_FOR_EACH_11, HAVSERILITE_FOR_EACH_10, HAVSERILITE_FOR_EACH_9, HAVSERILITE_FOR_EACH_8, HAVSERILITE_FOR_EACH_7, HAVSERILITE_FOR_EACH_6, HAVSERILITE_FOR_EACH_5, HAVSERILITE_FOR_EACH_4, HAVSERILITE_FOR_EACH_3, HAVSERILITE_FOR_EACH_2, HAVSERILITE_FOR_EACH_1)(macro, type, __VA_ARGS__))
+#define HAVSERILITE_FIELD_ENTRY(type, member) havSeriLite::havSeriLiteField<type, decltype(type::member)> { havSeriLite::GetFieldName(#member), &type::member }
+
+// Note: Describes the serialized fields of "type" for "havSeriLite::Write" and "havSeriLite::Read", e.g.
+// HAVSERILITE_FIELDS(Person, mFirstName, mLastName, mAge). Use it at namespace scope in the namespace of "type".
+#define HAVSERILITE_FIELDS(type, ...) \
+    [[maybe_unused]] inline constexpr auto havSeriLiteDescribe(const type*) \
+    { \
+        return std::make_tuple(HAVSERILITE_FOR_EACH(HAVSERILITE_FIELD_ENTRY, type, __VA_ARGS__)); \
+    }
 
 #endif